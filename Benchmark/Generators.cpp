@@ -0,0 +1,175 @@
+#include "Generators.hpp"
+#include <set>
+#include <vector>
+#include <random>
+#include <cassert>
+
+namespace {
+    auto join(const std::vector<std::string> &list) -> std::string {
+        std::string ret;
+        for (const auto &elem : list) {
+            if (!ret.empty()) {
+                ret.push_back(',');
+            }
+
+            ret.append(elem);
+        }
+
+        return ret;
+    }
+
+    /**
+     * Appends one action line
+     */
+    void action(std::string &out, const std::string &name, const std::vector<std::string> &pre,
+                const std::vector<std::string> &add, const std::vector<std::string> &del) {
+        out.append(name).append(";").append(join(pre)).append(";;").append(join(add)).append(";")
+           .append(join(del)).append("\n");
+    }
+
+    /**
+     * Appends a complete state: every fact of all that is not in pos is listed as negative
+     */
+    void state(std::string &out, const std::vector<std::string> &all, const std::set<std::string> &pos) {
+        std::vector<std::string> posList;
+        std::vector<std::string> negList;
+        for (const auto &f : all) {
+            (pos.contains(f) ? posList : negList).emplace_back(f);
+        }
+
+        out.append(join(posList)).append(";").append(join(negList)).append("\n");
+    }
+}
+
+namespace generators {
+    auto navigation(std::size_t n, std::size_t degree, std::uint64_t seed) -> std::string {
+        assert(n >= 2 && degree >= 1);
+        std::mt19937_64 random(seed);
+        std::uniform_int_distribution<std::size_t> node(0, n - 1);
+        std::set<std::pair<std::size_t, std::size_t>> edges;
+        for (std::size_t i = 0; i < n; ++i) {
+            edges.emplace(i, (i + 1) % n);
+            for (std::size_t d = 1; d < degree; ++d) {
+                auto j = node(random);
+                if (j != i) {
+                    edges.emplace(i, j);
+                }
+            }
+        }
+
+        auto at = [](std::size_t i) { return "at" + std::to_string(i); };
+        auto connected = [](std::size_t i, std::size_t j) {
+            return "verbunden" + std::to_string(i) + "_" + std::to_string(j);
+        };
+
+        std::vector<std::string> facts;
+        std::set<std::string> start = {at(0)};
+        for (std::size_t i = 0; i < n; ++i) {
+            facts.emplace_back(at(i));
+        }
+
+        for (auto [i, j] : edges) {
+            facts.emplace_back(connected(i, j));
+            start.emplace(connected(i, j));
+        }
+
+        std::string out;
+        state(out, facts, start);
+        out.append(at(n - 1)).append(";\n");
+        for (auto [i, j] : edges) {
+            action(out, "move" + std::to_string(i) + "_" + std::to_string(j), {connected(i, j), at(i)}, {at(j)},
+                   {at(i)});
+        }
+
+        return out;
+    }
+
+    auto blocksworld(std::size_t n) -> std::string {
+        assert(n >= 2);
+        const std::string floor = "Floor";
+        auto on = [](const std::string &x, const std::string &y) { return "on" + x + "_" + y; };
+        auto clear = [](const std::string &x) { return "clear" + x; };
+        std::vector<std::string> blocks;
+        for (std::size_t i = 0; i < n; ++i) {
+            blocks.emplace_back(blockName(i));
+        }
+
+        std::vector<std::string> facts;
+        for (const auto &x : blocks) {
+            facts.emplace_back(on(x, floor));
+            for (const auto &y : blocks) {
+                if (x != y) {
+                    facts.emplace_back(on(x, y));
+                }
+            }
+
+            facts.emplace_back(clear(x));
+        }
+
+        std::set<std::string> start;
+        for (std::size_t i = 0; i + 1 < n; ++i) {
+            start.emplace(on(blocks[i], floor));
+        }
+
+        start.emplace(on(blocks[n - 1], blocks[0]));
+        for (std::size_t i = 1; i < n; ++i) {
+            start.emplace(clear(blocks[i]));
+        }
+
+        std::vector<std::string> target = {on(blocks[n - 1], floor)};
+        for (std::size_t i = n - 1; i > 0; --i) {
+            target.emplace_back(on(blocks[i - 1], blocks[i]));
+        }
+
+        std::string out;
+        state(out, facts, start);
+        out.append(join(target)).append(";\n");
+        // move x from y to z, the floor is always clear
+        for (const auto &x : blocks) {
+            for (const auto &y : blocks) {
+                if (x == y) {
+                    continue;
+                }
+
+                action(out, "move" + x + "_" + y + "_" + floor, {on(x, y), clear(x)}, {on(x, floor), clear(y)},
+                       {on(x, y)});
+                action(out, "move" + x + "_" + floor + "_" + y, {on(x, floor), clear(x), clear(y)}, {on(x, y)},
+                       {on(x, floor), clear(y)});
+                for (const auto &z : blocks) {
+                    if (z != x && z != y) {
+                        action(out, "move" + x + "_" + y + "_" + z, {on(x, y), clear(x), clear(z)},
+                               {on(x, z), clear(y)}, {on(x, y), clear(z)});
+                    }
+                }
+            }
+        }
+
+        return out;
+    }
+
+    auto chain(std::size_t n) -> std::string {
+        auto pos = [](std::size_t i) { return "pos" + std::to_string(i); };
+        std::vector<std::string> facts;
+        for (std::size_t i = 0; i <= n; ++i) {
+            facts.emplace_back(pos(i));
+        }
+
+        std::string out;
+        state(out, facts, {pos(0)});
+        out.append(pos(n)).append(";\n");
+        for (std::size_t i = 0; i < n; ++i) {
+            action(out, "forward" + std::to_string(i), {pos(i)}, {pos(i + 1)}, {pos(i)});
+            action(out, "back" + std::to_string(i), {pos(i + 1)}, {pos(i)}, {pos(i + 1)});
+        }
+
+        return out;
+    }
+
+    auto blockName(std::size_t i) -> std::string {
+        if (i < 26) {
+            return std::string(1, static_cast<char>('A' + i));
+        }
+
+        return "B" + std::to_string(i);
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef BENCHMARK_GENERATORS_HPP
+#define BENCHMARK_GENERATORS_HPP
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Parameterised families of planning tasks in the STRIPS format of Blatt2
+ * pos;neg                  (start state)
+ * pos;neg                  (target)
+ * name;pre+;pre-;add;del   (one line per action)
+ * The start state lists every fact (AStar requires a complete start state) and no action has negative
+ * preconditions, so every instance can be solved by BFS, GraphSearch and AStar
+ */
+namespace generators {
+    /**
+     * Graph navigation as in Blatt4/res/sample-Graph: node i is connected to i + 1 (so that the last node is
+     * reachable) and to degree - 1 further random nodes. The agent starts at node 0 and has to reach node n - 1
+     * @param n number of nodes
+     * @param degree outgoing edges per node
+     * @param seed
+     * @return
+     */
+    auto navigation(std::size_t n, std::size_t degree, std::uint64_t seed) -> std::string;
+
+    /**
+     * Blocksworld with the instance of Blatt3/main.cpp generalised to n blocks: all blocks but the last one are on
+     * the floor, the last one is on the first one. Target is the reversed tower with the last block at the bottom
+     * @param n number of blocks, at least 2
+     * @return
+     */
+    auto blocksworld(std::size_t n) -> std::string;
+
+    /**
+     * Chain of n + 1 positions with steps in both directions, the target is the far end of the chain
+     * @param n
+     * @return
+     */
+    auto chain(std::size_t n) -> std::string;
+
+    /**
+     * Name of block i as used by blocksworld and Blatt3 (A, B, ... and B26, B27, ... afterwards)
+     * @param i
+     * @return
+     */
+    auto blockName(std::size_t i) -> std::string;
+}
+
+#endif //BENCHMARK_GENERATORS_HPP
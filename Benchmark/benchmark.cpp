@@ -0,0 +1,218 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+/*
+ * End to end benchmark. Generates the instance families and runs every given planner on them, each run in its own
+ * process. The peak RSS is taken from wait4. Linux carries the high water mark of the forking process over to the
+ * child, so the instances are generated by GenerateInstances in a child process as well and this process stays
+ * small. The planners report their counters through STRIPS_STATS_FD. Every run is printed as one JSON object per line
+ * with a fixed key order: family, size, tool, status (ok/timeout/error), planFound, wallSeconds, searchSeconds,
+ * expansions, expansionsPerSecond, peakRssKiB
+ *
+ * RunBenchmarks [--timeout=<seconds>] [--quick] [--generator=<path>] <tool>=<path>...
+ * The generator defaults to the GenerateInstances next to this executable.
+ * Tools named Blatt3 are lifted planners that get the number of blocks as argument and only run blocksworld, all
+ * other tools get the path of the instance file. The benchmark target passes the optimised builds of the planners
+ * without the sanitizer (Benchmark/planners), the targets of the exercises are debug builds with AddressSanitizer.
+ */
+
+struct Instance {
+    std::string family;
+    std::size_t size;
+};
+
+struct Tool {
+    std::string name;
+    std::string path;
+
+    [[nodiscard]] bool isLifted() const {
+        return name == "Blatt3";
+    }
+};
+
+struct Result {
+    std::string status;
+    bool planFound = false;
+    double wallSeconds = 0;
+    double searchSeconds = 0;
+    std::size_t expansions = 0;
+    long peakRssKiB = 0;
+};
+
+auto suite(bool quick) -> std::vector<Instance> {
+    if (quick) {
+        return {{"navigation", 100}, {"blocksworld", 3}, {"chain", 10}};
+    }
+
+    return {{"navigation", 100}, {"navigation", 1000}, {"navigation", 10000},
+            {"blocksworld", 3}, {"blocksworld", 4}, {"blocksworld", 5}, {"blocksworld", 6},
+            {"chain", 10}, {"chain", 100}, {"chain", 1000}};
+}
+
+auto statsValue(const std::string &stats, const std::string &key) -> double {
+    auto pos = stats.find("\"" + key + "\":");
+    if (pos == std::string::npos) {
+        return 0;
+    }
+
+    return std::strtod(stats.c_str() + pos + key.size() + 3, nullptr);
+}
+
+/**
+ * Runs args in a child process with stdout redirected to output
+ * @param args
+ * @param output
+ * @param timeout
+ * @return
+ */
+auto run(const std::vector<std::string> &args, const std::string &output, std::chrono::duration<double> timeout)
+    -> Result {
+    int statsPipe[2];
+    if (::pipe(statsPipe) != 0) {
+        return {"error"};
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+        ::close(statsPipe[0]);
+        ::close(statsPipe[1]);
+        return {"error"};
+    }
+
+    if (pid == 0) {
+        ::close(statsPipe[0]);
+        const int out = ::open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        const int null = ::open("/dev/null", O_WRONLY);
+        if (out < 0 || null < 0) {
+            ::_exit(127);
+        }
+
+        ::dup2(out, STDOUT_FILENO);
+        ::dup2(null, STDERR_FILENO);
+        ::setenv("STRIPS_STATS_FD", std::to_string(statsPipe[1]).c_str(), 1);
+        std::vector<char *> argv;
+        for (const auto &a : args) {
+            argv.emplace_back(const_cast<char *>(a.c_str()));
+        }
+
+        argv.emplace_back(nullptr);
+        ::execv(argv[0], argv.data());
+        ::_exit(127);
+    }
+
+    ::close(statsPipe[1]);
+    Result result;
+    int status = 0;
+    rusage usage{};
+    bool timedOut = false;
+    while (::wait4(pid, &status, WNOHANG, &usage) == 0) {
+        if (std::chrono::steady_clock::now() - begin > timeout) {
+            ::kill(pid, SIGKILL);
+            ::wait4(pid, &status, 0, &usage);
+            timedOut = true;
+            break;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    result.peakRssKiB = usage.ru_maxrss;
+    std::string stats;
+    char buffer[512];
+    ssize_t n;
+    while ((n = ::read(statsPipe[0], buffer, sizeof(buffer))) > 0) {
+        stats.append(buffer, static_cast<std::size_t>(n));
+    }
+
+    ::close(statsPipe[0]);
+    if (timedOut) {
+        result.status = "timeout";
+        return result;
+    }
+
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        result.status = "error";
+        return result;
+    }
+
+    result.status = "ok";
+    result.expansions = static_cast<std::size_t>(statsValue(stats, "expansions"));
+    result.searchSeconds = statsValue(stats, "search");
+    std::ifstream planFile(output);
+    std::string firstLine;
+    std::getline(planFile, firstLine);
+    result.planFound = firstLine != "Unloesbar" && firstLine != "-1" && firstLine != "Unsolvable!";
+    return result;
+}
+
+int main(int argc, char **argv) {
+    double timeoutSeconds = 10;
+    bool quick = false;
+    auto generator = (std::filesystem::path(argv[0]).parent_path() / "GenerateInstances").string();
+    std::vector<Tool> tools;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.starts_with("--timeout=")) {
+            timeoutSeconds = std::strtod(arg.c_str() + 10, nullptr);
+        } else if (arg == "--quick") {
+            quick = true;
+        } else if (arg.starts_with("--generator=")) {
+            generator = arg.substr(12);
+        } else if (auto eq = arg.find('='); eq != std::string::npos) {
+            tools.push_back({arg.substr(0, eq), arg.substr(eq + 1)});
+        } else {
+            std::cerr << "usage: " << argv[0]
+                      << " [--timeout=<seconds>] [--quick] [--generator=<path>] <tool>=<path>..." << std::endl;
+            return 1;
+        }
+    }
+
+    const auto dir = std::filesystem::temp_directory_path() / ("strips-benchmark-" + std::to_string(::getpid()));
+    std::filesystem::create_directories(dir);
+    const auto output = (dir / "plan.out").string();
+    for (const auto &instance : suite(quick)) {
+        const auto instancePath = (dir / (instance.family + std::to_string(instance.size) + ".in")).string();
+        const auto generated = run({generator, instance.family, std::to_string(instance.size)}, instancePath,
+                                   std::chrono::duration<double>(timeoutSeconds));
+        if (generated.status != "ok") {
+            std::cerr << "Cannot generate " << instance.family << " " << instance.size << std::endl;
+            continue;
+        }
+
+        for (const auto &tool : tools) {
+            if (tool.isLifted() && instance.family != "blocksworld") {
+                continue;
+            }
+
+            const auto argument = tool.isLifted() ? std::to_string(instance.size) : instancePath;
+            const auto r = run({tool.path, argument}, output, std::chrono::duration<double>(timeoutSeconds));
+            const double perSecond = r.searchSeconds > 0 ? static_cast<double>(r.expansions) / r.searchSeconds : 0;
+            char line[512];
+            std::snprintf(line, sizeof(line),
+                          "{\"family\":\"%s\",\"size\":%zu,\"tool\":\"%s\",\"status\":\"%s\",\"planFound\":%s,"
+                          "\"wallSeconds\":%.6f,\"searchSeconds\":%.6f,\"expansions\":%zu,"
+                          "\"expansionsPerSecond\":%.1f,\"peakRssKiB\":%ld}",
+                          instance.family.c_str(), instance.size, tool.name.c_str(), r.status.c_str(),
+                          r.planFound ? "true" : "false", r.wallSeconds, r.searchSeconds, r.expansions, perSecond,
+                          r.peakRssKiB);
+            std::cout << line << std::endl;
+        }
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,35 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include "Generators.hpp"
+
+/*
+ * Writes a single instance to stdout
+ * GenerateInstances navigation <nodes> [degree = 3] [seed = 0]
+ * GenerateInstances blocksworld <blocks>
+ * GenerateInstances chain <length>
+ */
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " navigation|blocksworld|chain <size> [degree] [seed]" << std::endl;
+        return 1;
+    }
+
+    const std::string family = argv[1];
+    const auto size = std::strtoull(argv[2], nullptr, 10);
+    if (family == "navigation") {
+        const auto degree = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 3;
+        const auto seed = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 0;
+        std::cout << generators::navigation(size, degree, seed);
+    } else if (family == "blocksworld") {
+        std::cout << generators::blocksworld(size);
+    } else if (family == "chain") {
+        std::cout << generators::chain(size);
+    } else {
+        std::cerr << "Unknown family " << family << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
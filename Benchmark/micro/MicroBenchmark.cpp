@@ -0,0 +1,183 @@
+#include "MicroBenchmark.hpp"
+#include <new>
+#include <map>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+namespace {
+    // the benchmarked code may allocate on the threads of a pool
+    std::atomic<std::size_t> numAllocations = 0;
+
+    using Clock = std::chrono::steady_clock;
+    constexpr std::chrono::milliseconds MinRunTime(50);
+    constexpr std::size_t Repetitions = 9;
+    // the timing of operations that take a few nanoseconds varies by more than any relative tolerance
+    constexpr double SlackNs = 2;
+
+    struct Baseline {
+        double nsPerOp;
+        double allocsPerOp;
+    };
+
+    auto readBaseline(const std::string &path) -> std::map<std::string, Baseline> {
+        std::map<std::string, Baseline> ret;
+        std::ifstream in(path);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line.front() == '#') {
+                continue;
+            }
+
+            std::istringstream fields(line);
+            std::string name;
+            Baseline b{};
+            if (fields >> name >> b.nsPerOp >> b.allocsPerOp) {
+                ret[name] = b;
+            }
+        }
+
+        return ret;
+    }
+
+    bool writeBaseline(const std::string &path, const std::map<std::string, Baseline> &baseline) {
+        std::ofstream out(path);
+        out << "# name nsPerOp allocsPerOp, written by the microbenchmarks with --update\n";
+        for (const auto &[name, b] : baseline) {
+            char line[256];
+            std::snprintf(line, sizeof(line), "%s %.2f %.2f\n", name.c_str(), b.nsPerOp, b.allocsPerOp);
+            out << line;
+        }
+
+        return static_cast<bool>(out);
+    }
+}
+
+// not inlined, otherwise GCC pairs the malloc and free of the replacements with new and delete in this file and warns
+[[gnu::noinline]] void *operator new(std::size_t size) {
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace micro {
+    auto allocations() -> std::size_t {
+        return numAllocations.load(std::memory_order_relaxed);
+    }
+
+    Suite::Suite(std::string prefix) : prefix(std::move(prefix)) {}
+
+    void Suite::add(const std::string &name, Body body) {
+        benchmarks.emplace_back(prefix + name, std::move(body));
+    }
+
+    auto Suite::measure(const Body &body) -> std::pair<double, double> {
+        auto timed = [&body](std::size_t n) {
+            const auto begin = Clock::now();
+            body(n);
+            return Clock::now() - begin;
+        };
+
+        std::size_t n = 1;
+        while (timed(n) < MinRunTime) {
+            n *= 2;
+        }
+
+        double bestNs = std::numeric_limits<double>::max();
+        double allocs = 0;
+        for (std::size_t i = 0; i < Repetitions; ++i) {
+            const auto before = allocations();
+            const auto elapsed = timed(n);
+            allocs = static_cast<double>(allocations() - before) / static_cast<double>(n);
+            bestNs = std::min(bestNs, std::chrono::duration<double, std::nano>(elapsed).count() /
+                                      static_cast<double>(n));
+        }
+
+        return {bestNs, allocs};
+    }
+
+    auto Suite::run(int argc, char **argv) -> int {
+        std::string baselinePath;
+        bool update = false;
+        bool time = false;
+        double tolerance = 0.5;
+        std::string filter;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg.starts_with("--baseline=")) {
+                baselinePath = arg.substr(11);
+            } else if (arg == "--update") {
+                update = true;
+            } else if (arg == "--time") {
+                time = true;
+            } else if (arg.starts_with("--tolerance=")) {
+                tolerance = std::strtod(arg.c_str() + 12, nullptr);
+            } else if (arg.starts_with("--filter=")) {
+                filter = arg.substr(9);
+            } else {
+                std::cerr << "usage: " << argv[0]
+                          << " [--baseline=<file>] [--update] [--time] [--tolerance=<fraction>] [--filter=<substring>]"
+                          << std::endl;
+                return 1;
+            }
+        }
+
+        if (update && baselinePath.empty()) {
+            std::cerr << "--update requires --baseline" << std::endl;
+            return 1;
+        }
+
+        auto baseline = baselinePath.empty() ? std::map<std::string, Baseline>() : readBaseline(baselinePath);
+        bool regressed = false;
+        for (const auto &[name, body] : benchmarks) {
+            if (name.find(filter) == std::string::npos) {
+                continue;
+            }
+
+            const auto [nsPerOp, allocsPerOp] = measure(body);
+            char line[256];
+            std::snprintf(line, sizeof(line), "%-48s %12.1f ns/op %8.2f allocs/op", name.c_str(), nsPerOp,
+                          allocsPerOp);
+            std::cout << line;
+            const auto old = baseline.find(name);
+            if (update) {
+                baseline[name] = {nsPerOp, allocsPerOp};
+            } else if (old != baseline.end()) {
+                const bool slower = time && nsPerOp > old->second.nsPerOp * (1 + tolerance) + SlackNs;
+                const bool allocates = allocsPerOp > old->second.allocsPerOp + 0.05;
+                std::snprintf(line, sizeof(line), "   (baseline %.1f ns/op %.2f allocs/op)", old->second.nsPerOp,
+                              old->second.allocsPerOp);
+                std::cout << line << (slower || allocates ? " REGRESSION" : "");
+                regressed = regressed || slower || allocates;
+            } else if (!baselinePath.empty()) {
+                std::cout << "   (no baseline)";
+            }
+
+            std::cout << std::endl;
+        }
+
+        if (update && !writeBaseline(baselinePath, baseline)) {
+            std::cerr << "Cannot write " << baselinePath << std::endl;
+            return 1;
+        }
+
+        return regressed ? 1 : 0;
+    }
+}
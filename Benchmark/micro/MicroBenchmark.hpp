@@ -0,0 +1,71 @@
+#ifndef BENCHMARK_MICROBENCHMARK_HPP
+#define BENCHMARK_MICROBENCHMARK_HPP
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <functional>
+
+/**
+ * Minimal microbenchmark harness. Every executable that uses it counts the calls of the global operator new, so the
+ * allocations per operation are exact
+ */
+namespace micro {
+    /**
+     * Keeps the compiler from optimising the computation of value away
+     * @param value
+     */
+    template<typename T>
+    inline void keep(const T &value) {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+    /**
+     * Number of calls of the global operator new so far
+     * @return
+     */
+    auto allocations() -> std::size_t;
+
+    struct Result {
+        std::string name;
+        double nsPerOp;
+        double allocsPerOp;
+    };
+
+    /**
+     * A named set of benchmarks. Each benchmark is a function that performs the given number of operations. The
+     * number of operations is doubled until a run takes long enough, the best of several runs is reported
+     */
+    class Suite {
+    public:
+        using Body = std::function<void(std::size_t)>;
+
+        /**
+         * @param prefix prepended to all benchmark names (e.g. "Blatt2/") so that several suites can share one
+         * baseline file
+         */
+        explicit Suite(std::string prefix);
+
+        void add(const std::string &name, Body body);
+
+        /**
+         * Runs all benchmarks and prints ns/op and allocs/op
+         * [--baseline=<file>] [--update] [--time] [--tolerance=<fraction>] [--filter=<substring>]
+         * With a baseline, a benchmark regresses if it allocates more often than the baseline. The allocations do not
+         * depend on the machine, the times do: only with --time a benchmark also regresses if it is slower than the
+         * baseline by more than the tolerance (default 0.5). --update writes the results of this suite into the
+         * baseline file instead
+         * @param argc
+         * @param argv
+         * @return exit code, 1 on a regression
+         */
+        auto run(int argc, char **argv) -> int;
+
+    private:
+        static auto measure(const Body &body) -> std::pair<double, double>;
+
+        std::string prefix;
+        std::vector<std::pair<std::string, Body>> benchmarks;
+    };
+}
+
+#endif //BENCHMARK_MICROBENCHMARK_HPP
@@ -0,0 +1,109 @@
+#include <string>
+#include <vector>
+#include <random>
+#include <fstream>
+#include <filesystem>
+#include <cstdlib>
+#include <unistd.h>
+#include "MicroBenchmark.hpp"
+#include "../Generators.hpp"
+#include "../../Blatt2/Task.hpp"
+
+/*
+ * Microbenchmarks of the Blatt2 primitives on the blocksworld instance with 8 blocks. The states are taken from a
+ * random walk starting in the start state.
+ * MicroBlatt2 [--baseline=<file>] [--update] [--tolerance=<fraction>] [--filter=<substring>]
+ */
+
+auto loadTask(const std::string &text) -> Task {
+    const auto path = std::filesystem::temp_directory_path() / ("strips-micro-" + std::to_string(::getpid()) + ".in");
+    std::ofstream(path) << text;
+    ::setenv("STRIPS_CACHE_DIR", "", 1);
+    auto task = Task::parse(InputBuffer::open(path.string()));
+    std::filesystem::remove(path);
+    return task;
+}
+
+auto randomWalk(const Task &task, std::size_t length) -> std::vector<State> {
+    std::vector<State> states = {task.getStart()};
+    std::mt19937_64 rng(0);
+    while (states.size() < length) {
+        std::vector<const Action *> applicable;
+        for (const auto &action : task.getActions()) {
+            if (action.applicable(states.back())) {
+                applicable.emplace_back(&action);
+            }
+        }
+
+        states.emplace_back(applicable[rng() % applicable.size()]->applyTo(states.back()));
+    }
+
+    return states;
+}
+
+int main(int argc, char **argv) {
+    const auto task = loadTask(generators::blocksworld(8));
+    const auto &actions = task.getActions();
+    const auto states = randomWalk(task, 64);
+    const auto copies = states;
+    std::vector<std::pair<const Action *, const State *>> applicablePairs;
+    for (const auto &state : states) {
+        for (const auto &action : actions) {
+            if (action.applicable(state)) {
+                applicablePairs.emplace_back(&action, &state);
+            }
+        }
+    }
+
+    micro::Suite suite("Blatt2/");
+    suite.add("Action::applicable", [&](std::size_t n) {
+        std::size_t a = 0;
+        std::size_t s = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            micro::keep(actions[a].applicable(states[s]));
+            if (++a == actions.size()) {
+                a = 0;
+                s = s + 1 == states.size() ? 0 : s + 1;
+            }
+        }
+    });
+    suite.add("Action::applyTo", [&](std::size_t n) {
+        std::size_t p = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto successor = applicablePairs[p].first->applyTo(*applicablePairs[p].second);
+            micro::keep(successor);
+            p = p + 1 == applicablePairs.size() ? 0 : p + 1;
+        }
+    });
+    suite.add("State::operator==(equal)", [&](std::size_t n) {
+        std::size_t s = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            micro::keep(states[s] == copies[s]);
+            s = s + 1 == states.size() ? 0 : s + 1;
+        }
+    });
+    suite.add("State::operator==(different)", [&](std::size_t n) {
+        std::size_t s = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            micro::keep(states[s] == states[s + 1]);
+            s = s + 2 == states.size() ? 0 : s + 1;
+        }
+    });
+    suite.add("State::Hash", [&](std::size_t n) {
+        const State::Hash hash;
+        std::size_t s = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            micro::keep(hash(states[s]));
+            s = s + 1 == states.size() ? 0 : s + 1;
+        }
+    });
+    suite.add("State::State(BitSet)", [&](std::size_t n) {
+        std::size_t s = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const State state(states[s].getFacts());
+            micro::keep(state.getHash());
+            s = s + 1 == states.size() ? 0 : s + 1;
+        }
+    });
+    return suite.run(argc, argv);
+}
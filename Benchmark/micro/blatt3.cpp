@@ -0,0 +1,67 @@
+#include <string>
+#include <vector>
+#include "MicroBenchmark.hpp"
+#include "../Generators.hpp"
+#include "../../Blatt3/VariablePredicate.hpp"
+#include "../../Blatt3/Operator.hpp"
+#include "../../Blatt3/State.hpp"
+
+/*
+ * Microbenchmarks of the Blatt3 primitives on the blocksworld start state with 5 blocks and the Move operator of
+ * Blatt3/main.cpp.
+ * MicroBlatt3 [--baseline=<file>] [--update] [--tolerance=<fraction>] [--filter=<substring>]
+ */
+
+auto startState(std::size_t numBlocks) -> State {
+    State::PredList preds;
+    for (std::size_t i = 0; i + 1 < numBlocks; ++i) {
+        preds.emplace_back("On", std::vector<std::string>{generators::blockName(i), "Floor"});
+    }
+
+    preds.emplace_back("On", std::vector<std::string>{generators::blockName(numBlocks - 1), generators::blockName(0)});
+    preds.emplace_back("Clear", std::vector<std::string>{"Floor"});
+    for (std::size_t i = 1; i < numBlocks; ++i) {
+        preds.emplace_back("Clear", std::vector<std::string>{generators::blockName(i)});
+    }
+
+    return State(std::move(preds));
+}
+
+int main(int argc, char **argv) {
+    const auto state = startState(5);
+    const Operator move("Move", {
+                                VariablePredicate("On", {"<X>", "<Y>"}),
+                                VariablePredicate("Clear", {"<X>"}),
+                                VariablePredicate("Clear", {"<Z>"})
+                        },
+                        {
+                                VariablePredicate("On", {"<X>", "<Z>"}),
+                                VariablePredicate("Clear", {"<Y>"}),
+                                VariablePredicate("Clear", {"Floor"}),
+                                VariablePredicate("On", {"<X>", "<Y>"}, false),
+                                VariablePredicate("Clear", {"<Z>"}, false)
+                        });
+    std::vector<std::pair<const VariablePredicate *, const VariablePredicate *>> pairs;
+    for (const auto &precondition : move.getPreconditions()) {
+        for (const auto &fact : state.getPredicates()) {
+            pairs.emplace_back(&precondition, &fact);
+        }
+    }
+
+    micro::Suite suite("Blatt3/");
+    suite.add("findSubstitution", [&](std::size_t n) {
+        std::size_t p = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto substitution = findSubstitution(*pairs[p].first, *pairs[p].second);
+            micro::keep(substitution);
+            p = p + 1 == pairs.size() ? 0 : p + 1;
+        }
+    });
+    suite.add("Operator::makeApplicable", [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto instantiations = move.makeApplicable(state, false);
+            micro::keep(instantiations);
+        }
+    });
+    return suite.run(argc, argv);
+}
@@ -0,0 +1,46 @@
+#include <string>
+#include <vector>
+#include <memory>
+#include <sstream>
+#include "MicroBenchmark.hpp"
+#include "../Generators.hpp"
+#include "../../Blatt4/PlanningGraph.hpp"
+
+/*
+ * Microbenchmarks of the Blatt4 planning graph on the blocksworld instance with 6 blocks. The layers are the first
+ * layers of the planning graph of the start state.
+ * MicroBlatt4 [--baseline=<file>] [--update] [--tolerance=<fraction>] [--filter=<substring>]
+ */
+
+int main(int argc, char **argv) {
+    std::istringstream instance(generators::blocksworld(6));
+    std::string startLine;
+    std::string targetLine;
+    std::getline(instance, startLine);
+    std::getline(instance, targetLine);
+    std::vector<searchGraph::cActionPtr> actions;
+    std::string line;
+    while (std::getline(instance, line)) {
+        actions.emplace_back(std::make_shared<searchGraph::Action>(line));
+    }
+
+    const searchGraph::FactLayer start(startLine);
+    const auto startActions = searchGraph::getValidActions(actions, start);
+    const auto layer = start.next(startActions);
+    const auto layerActions = searchGraph::getValidActions(actions, layer);
+    micro::Suite suite("Blatt4/");
+    suite.add("FactLayer::isApplicable", [&](std::size_t n) {
+        std::size_t a = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            micro::keep(layer.isApplicable(*actions[a]));
+            a = a + 1 == actions.size() ? 0 : a + 1;
+        }
+    });
+    suite.add("FactLayer::next", [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto nextLayer = layer.next(layerActions);
+            micro::keep(nextLayer);
+        }
+    });
+    return suite.run(argc, argv);
+}
@@ -0,0 +1,116 @@
+#include "Action.hpp"
+#include "Zobrist.hpp"
+#include <cassert>
+
+Action::Action(std::string_view name, Condition preconditions, BitSet add, BitSet del) : name(name),
+    preconditions(std::move(preconditions)), add(std::move(add)), del(std::move(del)) {
+    this->add.subtract(this->del);
+    this->add.forEach([this](FactId id) { addList.emplace_back(id); });
+    this->del.forEach([this](FactId id) { delList.emplace_back(id); });
+}
+
+auto Action::getName() const -> std::string_view {
+    return name;
+}
+
+auto Action::getPreconditions() const -> const Condition & {
+    return preconditions;
+}
+
+auto Action::getAddEffects() const -> const BitSet & {
+    return add;
+}
+
+auto Action::getDelEffects() const -> const BitSet & {
+    return del;
+}
+
+bool Action::applicable(const State &state) const {
+    return preconditions.satisfiedBy(state.getFacts());
+}
+
+State Action::applyTo(const State &state) const {
+    assert(applicable(state));
+    const auto &oldFacts = state.getFacts();
+    auto hash = state.getHash();
+    for (auto id : addList) {
+        if (!oldFacts.test(id)) {
+            hash ^= zobrist::key(id);
+        }
+    }
+
+    for (auto id : delList) {
+        if (oldFacts.test(id)) {
+            hash ^= zobrist::key(id);
+        }
+    }
+
+    auto unsatisfied = state.getUnsatisfiedGoals();
+    if (unsatisfied != State::Untracked) {
+        for (const auto &e : goalEffects) {
+            if (oldFacts.test(e.id) != e.add) {
+                unsatisfied = e.satisfies ? unsatisfied - 1 : unsatisfied + 1;
+            }
+        }
+    }
+
+    BitSet facts = oldFacts;
+    facts.apply(add, del);
+    return State(std::move(facts), hash, unsatisfied);
+}
+
+void Action::applyInPlace(State &state, std::vector<FactId> &trail) const {
+    assert(applicable(state));
+    for (auto id : addList) {
+        if (!state.getFacts().test(id)) {
+            state.flip(id);
+            trail.emplace_back(id);
+        }
+    }
+
+    for (auto id : delList) {
+        if (state.getFacts().test(id)) {
+            state.flip(id);
+            trail.emplace_back(id);
+        }
+    }
+}
+
+void Action::trackGoal(const Condition &goal) {
+    goalEffects.clear();
+    for (auto id : addList) {
+        if (goal.getPositive().test(id) || goal.getNegative().test(id)) {
+            goalEffects.push_back({id, true, goal.getPositive().test(id)});
+        }
+    }
+
+    for (auto id : delList) {
+        if (goal.getPositive().test(id) || goal.getNegative().test(id)) {
+            goalEffects.push_back({id, false, goal.getNegative().test(id)});
+        }
+    }
+}
+
+auto Action::regress(const Condition &condition) const -> std::optional<Condition> {
+    const auto &pos = condition.getPositive();
+    const auto &neg = condition.getNegative();
+    if (!add.intersects(pos) && !del.intersects(neg)) {
+        return {};
+    }
+
+    if (add.intersects(neg) || del.intersects(pos)) {
+        return {};
+    }
+
+    BitSet newPos = pos;
+    newPos.subtract(add);
+    newPos |= preconditions.getPositive();
+    BitSet newNeg = neg;
+    newNeg.subtract(del);
+    newNeg |= preconditions.getNegative();
+    if (newPos.intersects(newNeg)) {
+        return {};
+    }
+
+    return Condition(std::move(newPos), std::move(newNeg));
+}
@@ -0,0 +1,76 @@
+#ifndef BLATT2_ACTION_HPP
+#define BLATT2_ACTION_HPP
+#include <string_view>
+#include <vector>
+#include <optional>
+#include "BitSet.hpp"
+#include "FactTable.hpp"
+#include "Condition.hpp"
+#include "State.hpp"
+
+class Action {
+public:
+    /**
+     * If a fact is both added and deleted, the delete effect wins (same as in the input format)
+     * @param name
+     * @param preconditions
+     * @param add
+     * @param del
+     */
+    Action(std::string_view name, Condition preconditions, BitSet add, BitSet del);
+    [[nodiscard]] auto getName() const -> std::string_view;
+    [[nodiscard]] auto getPreconditions() const -> const Condition &;
+    [[nodiscard]] auto getAddEffects() const -> const BitSet &;
+    [[nodiscard]] auto getDelEffects() const -> const BitSet &;
+    [[nodiscard]] bool applicable(const State &state) const;
+
+    /**
+     * Computes the successor state. The zobrist hash is updated from the facts that actually change
+     * @param state
+     * @return
+     */
+    [[nodiscard]] State applyTo(const State &state) const;
+
+    /**
+     * Applies the action to state in place. Every fact that actually changes is appended to trail, flipping them
+     * back (in any order) restores the old state
+     * @param state
+     * @param trail
+     */
+    void applyInPlace(State &state, std::vector<FactId> &trail) const;
+
+    /**
+     * Prepares applyTo to update the goal counter of tracking states
+     * @param goal
+     */
+    void trackGoal(const Condition &goal);
+
+    /**
+     * Regression of a partial state. The action has to achieve at least one literal of condition and must not
+     * contradict any other one
+     * @param condition
+     * @return condition that has to hold before the action such that condition holds afterwards, empty if the
+     * action is not relevant or not consistent with condition
+     */
+    [[nodiscard]] auto regress(const Condition &condition) const -> std::optional<Condition>;
+
+private:
+    /**
+     * Effect on a goal literal, only counts if the fact actually changes
+     */
+    struct GoalEffect {
+        FactId id;
+        bool add;
+        bool satisfies;
+    };
+
+    std::string_view name;
+    Condition preconditions;
+    BitSet add;
+    BitSet del;
+    std::vector<FactId> addList;
+    std::vector<FactId> delList;
+    std::vector<GoalEffect> goalEffects;
+};
+
+#endif //BLATT2_ACTION_HPP
@@ -0,0 +1,179 @@
+#ifndef BLATT2_BITSET_HPP
+#define BLATT2_BITSET_HPP
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <bit>
+#include <algorithm>
+
+/**
+ * Fixed size set of fact ids packed into 64 bit words. All binary operations require both operands to have the same
+ * size. The operations are used in the innermost search loops and are therefore defined inline
+ */
+class BitSet {
+public:
+    using Word = std::uint64_t;
+    static constexpr std::size_t WordBits = 64;
+
+    struct Hash {
+        std::size_t operator()(const BitSet &b) const {
+            std::uint64_t h = b.numBits;
+            for (auto w : b.words) {
+                h ^= w + 0x9e3779b97f4a7c15ull + (h << 6u) + (h >> 2u);
+            }
+
+            return h;
+        }
+    };
+
+    BitSet() = default;
+    explicit BitSet(std::size_t size) : numBits(size), words((size + WordBits - 1) / WordBits, 0) {}
+
+    /**
+     * Copies a packed set, e.g. one that was read back from disk
+     * @param size
+     * @param data (size + WordBits - 1) / WordBits words as returned by getWords
+     */
+    BitSet(std::size_t size, const Word *data) : numBits(size), words(data, data + (size + WordBits - 1) / WordBits) {}
+
+    void set(std::size_t i) {
+        assert(i < numBits);
+        words[i / WordBits] |= Word(1) << (i % WordBits);
+    }
+
+    void reset(std::size_t i) {
+        assert(i < numBits);
+        words[i / WordBits] &= ~(Word(1) << (i % WordBits));
+    }
+
+    [[nodiscard]] bool test(std::size_t i) const {
+        assert(i < numBits);
+        return (words[i / WordBits] >> (i % WordBits)) & 1u;
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t {
+        return numBits;
+    }
+
+    void clear() {
+        std::fill(words.begin(), words.end(), 0);
+    }
+
+    [[nodiscard]] auto count() const -> std::size_t {
+        std::size_t ret = 0;
+        for (auto w : words) {
+            ret += static_cast<std::size_t>(std::popcount(w));
+        }
+
+        return ret;
+    }
+
+    [[nodiscard]] bool none() const {
+        for (auto w : words) {
+            if (w != 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * True if every bit set in this is also set in other
+     * @param other
+     * @return
+     */
+    [[nodiscard]] bool subsetOf(const BitSet &other) const {
+        assert(numBits == other.numBits);
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            if ((words[i] & ~other.words[i]) != 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] bool intersects(const BitSet &other) const {
+        assert(numBits == other.numBits);
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            if ((words[i] & other.words[i]) != 0) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * this = (this & ~del) | add
+     * @param add
+     * @param del
+     */
+    void apply(const BitSet &add, const BitSet &del) {
+        assert(numBits == add.numBits && numBits == del.numBits);
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            words[i] = (words[i] & ~del.words[i]) | add.words[i];
+        }
+    }
+
+    auto operator&=(const BitSet &other) -> BitSet & {
+        assert(numBits == other.numBits);
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            words[i] &= other.words[i];
+        }
+
+        return *this;
+    }
+
+    auto operator|=(const BitSet &other) -> BitSet & {
+        assert(numBits == other.numBits);
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            words[i] |= other.words[i];
+        }
+
+        return *this;
+    }
+
+    /**
+     * Removes all bits that are set in other
+     * @param other
+     * @return
+     */
+    auto subtract(const BitSet &other) -> BitSet & {
+        assert(numBits == other.numBits);
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            words[i] &= ~other.words[i];
+        }
+
+        return *this;
+    }
+
+    /**
+     * Calls fun with the index of every set bit in ascending order
+     * @param fun
+     */
+    template<typename FUN>
+    void forEach(FUN &&fun) const {
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            auto w = words[i];
+            while (w != 0) {
+                fun(i * WordBits + static_cast<std::size_t>(std::countr_zero(w)));
+                w &= w - 1;
+            }
+        }
+    }
+
+    [[nodiscard]] auto getWords() const -> const std::vector<Word> & {
+        return words;
+    }
+
+    bool operator==(const BitSet &other) const = default;
+
+private:
+    std::size_t numBits = 0;
+    std::vector<Word> words;
+};
+
+#endif //BLATT2_BITSET_HPP
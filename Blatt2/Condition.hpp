@@ -0,0 +1,76 @@
+#ifndef BLATT2_CONDITION_HPP
+#define BLATT2_CONDITION_HPP
+#include "BitSet.hpp"
+
+/**
+ * Partial assignment of facts: every fact in positive has to be true, every fact in negative has to be false, all
+ * other facts are irrelevant. Used for preconditions and for the target
+ */
+class Condition {
+public:
+    struct Hash {
+        std::size_t operator()(const Condition &c) const {
+            BitSet::Hash h;
+            return h(c.positive) * 31 + h(c.negative);
+        }
+    };
+
+    Condition() = default;
+
+    /**
+     * If a fact is contained in both sets, the negative literal wins (same as in the input format)
+     * @param positive
+     * @param negative
+     */
+    Condition(BitSet positive, BitSet negative) : positive(std::move(positive)), negative(std::move(negative)) {
+        this->positive.subtract(this->negative);
+    }
+
+    [[nodiscard]] bool satisfiedBy(const BitSet &facts) const {
+        return positive.subsetOf(facts) && !negative.intersects(facts);
+    }
+
+    /**
+     * Number of literals that do not hold in facts
+     * @param facts
+     * @return
+     */
+    [[nodiscard]] auto countViolated(const BitSet &facts) const -> std::size_t {
+        const auto &pos = positive.getWords();
+        const auto &neg = negative.getWords();
+        const auto &f = facts.getWords();
+        assert(pos.size() == f.size());
+        std::size_t ret = 0;
+        for (std::size_t i = 0; i < f.size(); ++i) {
+            ret += static_cast<std::size_t>(std::popcount(pos[i] & ~f[i]) + std::popcount(neg[i] & f[i]));
+        }
+
+        return ret;
+    }
+
+    [[nodiscard]] auto getPositive() const -> const BitSet & {
+        return positive;
+    }
+
+    [[nodiscard]] auto getNegative() const -> const BitSet & {
+        return negative;
+    }
+
+    /**
+     * Facts that are constrained by this condition (positive | negative)
+     * @return
+     */
+    [[nodiscard]] auto getCared() const -> BitSet {
+        BitSet ret = positive;
+        ret |= negative;
+        return ret;
+    }
+
+    bool operator==(const Condition &other) const = default;
+
+private:
+    BitSet positive;
+    BitSet negative;
+};
+
+#endif //BLATT2_CONDITION_HPP
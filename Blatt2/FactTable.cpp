@@ -0,0 +1,40 @@
+#include "FactTable.hpp"
+#include "util.hpp"
+#include <cassert>
+
+auto FactTable::intern(std::string_view name) -> FactId {
+    auto [it, inserted] = ids.emplace(name, names.size());
+    if (inserted) {
+        names.emplace_back(name);
+    }
+
+    return it->second;
+}
+
+void FactTable::internList(std::string_view list, std::vector<FactId> &result) {
+    util::Tokenizer tokens(list, ',');
+    std::string_view name;
+    while (tokens.next(name)) {
+        if (!name.empty()) {
+            result.emplace_back(intern(name));
+        }
+    }
+}
+
+auto FactTable::find(std::string_view name) const -> std::optional<FactId> {
+    auto res = ids.find(name);
+    if (res == ids.end()) {
+        return {};
+    }
+
+    return res->second;
+}
+
+auto FactTable::getName(FactId id) const -> std::string_view {
+    assert(id < names.size());
+    return names[id];
+}
+
+auto FactTable::size() const -> std::size_t {
+    return names.size();
+}
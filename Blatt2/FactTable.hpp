@@ -0,0 +1,40 @@
+#ifndef BLATT2_FACTTABLE_HPP
+#define BLATT2_FACTTABLE_HPP
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+
+using FactId = std::size_t;
+
+/**
+ * Maps fact names to dense integer ids. Ids are handed out in order of first occurrence, so they can directly be
+ * used as bit positions in a BitSet. The table does not own the names, they have to outlive it (usually they point
+ * into the InputBuffer of the Task)
+ */
+class FactTable {
+public:
+    /**
+     * Returns the id of the given fact, assigning a new one if the fact is not yet known
+     * @param name
+     * @return
+     */
+    auto intern(std::string_view name) -> FactId;
+
+    /**
+     * Interns every non empty entry of a comma separated fact list
+     * @param list
+     * @param result the ids are appended
+     */
+    void internList(std::string_view list, std::vector<FactId> &result);
+
+    [[nodiscard]] auto find(std::string_view name) const -> std::optional<FactId>;
+    [[nodiscard]] auto getName(FactId id) const -> std::string_view;
+    [[nodiscard]] auto size() const -> std::size_t;
+
+private:
+    std::unordered_map<std::string_view, FactId> ids;
+    std::vector<std::string_view> names;
+};
+
+#endif //BLATT2_FACTTABLE_HPP
@@ -0,0 +1,96 @@
+#include "InputBuffer.hpp"
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+auto InputBuffer::open(const std::string &path) -> InputBuffer {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path + ": " + std::strerror(errno));
+    }
+
+    auto ret = fromDescriptor(fd);
+    ::close(fd);
+    return ret;
+}
+
+auto InputBuffer::fromStdin() -> InputBuffer {
+    return fromDescriptor(STDIN_FILENO);
+}
+
+auto InputBuffer::fromDescriptor(int fd) -> InputBuffer {
+    InputBuffer ret;
+    struct stat info{};
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        auto size = static_cast<std::size_t>(info.st_size);
+        void *addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            ::madvise(addr, size, MADV_SEQUENTIAL);
+            ret.mapped = static_cast<const char *>(addr);
+            ret.mappedSize = size;
+            return ret;
+        }
+    }
+
+    constexpr std::size_t ChunkSize = 1 << 16;
+    std::size_t used = 0;
+    while (true) {
+        ret.owned.resize(used + ChunkSize);
+        auto n = ::read(fd, ret.owned.data() + used, ChunkSize);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n <= 0) {
+            break;
+        }
+
+        used += static_cast<std::size_t>(n);
+    }
+
+    ret.owned.resize(used);
+    return ret;
+}
+
+InputBuffer::InputBuffer(InputBuffer &&other) noexcept : mapped(other.mapped), mappedSize(other.mappedSize),
+    owned(std::move(other.owned)) {
+    other.mapped = nullptr;
+    other.mappedSize = 0;
+}
+
+auto InputBuffer::operator=(InputBuffer &&other) noexcept -> InputBuffer & {
+    if (this != &other) {
+        release();
+        mapped = other.mapped;
+        mappedSize = other.mappedSize;
+        owned = std::move(other.owned);
+        other.mapped = nullptr;
+        other.mappedSize = 0;
+    }
+
+    return *this;
+}
+
+InputBuffer::~InputBuffer() {
+    release();
+}
+
+void InputBuffer::release() {
+    if (mapped != nullptr) {
+        ::munmap(const_cast<char *>(mapped), mappedSize);
+        mapped = nullptr;
+        mappedSize = 0;
+    }
+}
+
+auto InputBuffer::getText() const -> std::string_view {
+    if (mapped != nullptr) {
+        return {mapped, mappedSize};
+    }
+
+    return {owned.data(), owned.size()};
+}
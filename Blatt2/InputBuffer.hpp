@@ -0,0 +1,45 @@
+#ifndef BLATT2_INPUTBUFFER_HPP
+#define BLATT2_INPUTBUFFER_HPP
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Read only view of a whole input file. Regular files are memory mapped, everything else (pipes) is read into an
+ * owned buffer. The text stays at the same address when the buffer is moved, so string_views into it remain valid
+ * as long as the buffer lives
+ */
+class InputBuffer {
+public:
+    /**
+     * Maps the file at path
+     * @param path
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    static auto open(const std::string &path) -> InputBuffer;
+
+    /**
+     * Maps stdin if it is redirected from a file, reads it completely otherwise
+     * @return
+     */
+    static auto fromStdin() -> InputBuffer;
+
+    InputBuffer(InputBuffer &&other) noexcept;
+    auto operator=(InputBuffer &&other) noexcept -> InputBuffer &;
+    InputBuffer(const InputBuffer &) = delete;
+    auto operator=(const InputBuffer &) -> InputBuffer & = delete;
+    ~InputBuffer();
+
+    [[nodiscard]] auto getText() const -> std::string_view;
+
+private:
+    InputBuffer() = default;
+    static auto fromDescriptor(int fd) -> InputBuffer;
+    void release();
+
+    const char *mapped = nullptr;
+    std::size_t mappedSize = 0;
+    std::vector<char> owned;
+};
+
+#endif //BLATT2_INPUTBUFFER_HPP
@@ -0,0 +1,59 @@
+#include "LineReader.hpp"
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+
+LineReader::LineReader(int fd, std::size_t bufferSize) : fd(fd), buffer(bufferSize) {}
+
+bool LineReader::next(std::string_view &line) {
+    std::size_t searchFrom = begin;
+    while (true) {
+        auto newline = static_cast<const char *>(std::memchr(buffer.data() + searchFrom, '\n', end - searchFrom));
+        if (newline != nullptr) {
+            const auto pos = static_cast<std::size_t>(newline - buffer.data());
+            line = {buffer.data() + begin, pos - begin};
+            begin = pos + 1;
+            return true;
+        }
+
+        searchFrom = end - begin;
+        if (!refill()) {
+            if (begin == end) {
+                return false;
+            }
+
+            line = {buffer.data() + begin, end - begin};
+            begin = end;
+            return true;
+        }
+    }
+}
+
+bool LineReader::refill() {
+    if (eof) {
+        return false;
+    }
+
+    // move the incomplete line to the front, grow if a single line does not fit
+    std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+    end -= begin;
+    begin = 0;
+    if (end == buffer.size()) {
+        buffer.resize(buffer.size() * 2);
+    }
+
+    while (true) {
+        auto n = ::read(fd, buffer.data() + end, buffer.size() - end);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n <= 0) {
+            eof = true;
+            return false;
+        }
+
+        end += static_cast<std::size_t>(n);
+        return true;
+    }
+}
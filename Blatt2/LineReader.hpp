@@ -0,0 +1,31 @@
+#ifndef BLATT2_LINEREADER_HPP
+#define BLATT2_LINEREADER_HPP
+#include <string_view>
+#include <vector>
+
+/**
+ * Reads lines from a file descriptor through a fixed buffer. Used for query streams that are too long (or never end)
+ * to be held in an InputBuffer
+ */
+class LineReader {
+public:
+    explicit LineReader(int fd, std::size_t bufferSize = 1 << 20);
+
+    /**
+     * Reads the next line without the trailing '\n'
+     * @param line is only valid until the next call
+     * @return false at the end of the stream
+     */
+    bool next(std::string_view &line);
+
+private:
+    bool refill();
+
+    int fd;
+    std::vector<char> buffer;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    bool eof = false;
+};
+
+#endif //BLATT2_LINEREADER_HPP
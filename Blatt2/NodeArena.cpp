@@ -0,0 +1,29 @@
+#include "NodeArena.hpp"
+#include <algorithm>
+#include <cassert>
+
+auto NodeArena::emplace(NodeId parent, std::size_t action) -> NodeId {
+    assert(parent == None || parent < nodes.size());
+    nodes.push_back({parent, action});
+    return nodes.size() - 1;
+}
+
+auto NodeArena::operator[](NodeId id) const -> const Node & {
+    assert(id < nodes.size());
+    return nodes[id];
+}
+
+auto NodeArena::size() const -> std::size_t {
+    return nodes.size();
+}
+
+auto NodeArena::extractPlan(NodeId id) const -> std::vector<std::size_t> {
+    std::vector<std::size_t> ret;
+    while (nodes[id].parent != None) {
+        ret.emplace_back(nodes[id].action);
+        id = nodes[id].parent;
+    }
+
+    std::reverse(ret.begin(), ret.end());
+    return ret;
+}
@@ -0,0 +1,43 @@
+#ifndef BLATT2_NODEARENA_HPP
+#define BLATT2_NODEARENA_HPP
+#include <vector>
+#include <cstddef>
+#include <limits>
+
+using NodeId = std::size_t;
+
+/**
+ * Stores the search tree as parent/action index pairs. The plan to a node is only built once by walking back to the
+ * root, so generating a node never copies a plan prefix
+ */
+class NodeArena {
+public:
+    static constexpr std::size_t None = std::numeric_limits<std::size_t>::max();
+
+    struct Node {
+        NodeId parent;
+        std::size_t action;
+    };
+
+    /**
+     * Adds a new node
+     * @param parent None for the root
+     * @param action index of the action that leads from parent to the new node, None for the root
+     * @return id of the new node
+     */
+    auto emplace(NodeId parent = None, std::size_t action = None) -> NodeId;
+    [[nodiscard]] auto operator[](NodeId id) const -> const Node &;
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    /**
+     * Action indices on the path from the root to id
+     * @param id
+     * @return
+     */
+    [[nodiscard]] auto extractPlan(NodeId id) const -> std::vector<std::size_t>;
+
+private:
+    std::vector<Node> nodes;
+};
+
+#endif //BLATT2_NODEARENA_HPP
@@ -0,0 +1,168 @@
+#include "RunFile.hpp"
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <cassert>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    constexpr std::size_t BufferBytes = 1 << 20;
+
+    auto bufferWords(std::size_t recordWords) -> std::size_t {
+        return std::max<std::size_t>(1, BufferBytes / (recordWords * sizeof(std::uint64_t))) * recordWords;
+    }
+
+    auto ioError(const std::string &what, const std::string &path) -> std::runtime_error {
+        return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+    }
+}
+
+RunWriter::RunWriter(const std::string &path, std::size_t recordWords) : path(path), recordWords(recordWords) {
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw ioError("Cannot create", path);
+    }
+
+    buffer.reserve(bufferWords(recordWords));
+}
+
+RunWriter::RunWriter(RunWriter &&other) noexcept : path(std::move(other.path)), fd(other.fd),
+    recordWords(other.recordWords), buffer(std::move(other.buffer)), written(other.written) {
+    other.fd = -1;
+}
+
+RunWriter::~RunWriter() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void RunWriter::write(const Word *record) {
+    buffer.insert(buffer.end(), record, record + recordWords);
+    ++written;
+    if (buffer.size() == buffer.capacity()) {
+        flush();
+    }
+}
+
+void RunWriter::close() {
+    flush();
+    if (::close(fd) != 0) {
+        fd = -1;
+        throw ioError("Cannot close", path);
+    }
+
+    fd = -1;
+}
+
+auto RunWriter::size() const -> std::uint64_t {
+    return written;
+}
+
+void RunWriter::flush() {
+    assert(fd >= 0);
+    auto data = reinterpret_cast<const char *>(buffer.data());
+    std::size_t remaining = buffer.size() * sizeof(Word);
+    while (remaining > 0) {
+        auto n = ::write(fd, data, remaining);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n < 0) {
+            throw ioError("Cannot write", path);
+        }
+
+        data += n;
+        remaining -= static_cast<std::size_t>(n);
+    }
+
+    buffer.clear();
+}
+
+RunReader::RunReader(const std::string &path, std::size_t recordWords) : path(path), recordWords(recordWords),
+    buffer(bufferWords(recordWords)) {
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw ioError("Cannot open", path);
+    }
+
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+}
+
+RunReader::RunReader(RunReader &&other) noexcept : path(std::move(other.path)), fd(other.fd),
+    recordWords(other.recordWords), buffer(std::move(other.buffer)), pos(other.pos), end(other.end),
+    started(other.started) {
+    other.fd = -1;
+}
+
+RunReader::~RunReader() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+bool RunReader::next() {
+    if (started) {
+        pos += recordWords;
+    }
+
+    started = true;
+    if (pos >= end && !refill()) {
+        return false;
+    }
+
+    return true;
+}
+
+auto RunReader::current() const -> const Word * {
+    assert(started && pos < end);
+    return buffer.data() + pos;
+}
+
+void RunReader::readAt(std::uint64_t index, Word *record) const {
+    const auto bytes = recordWords * sizeof(Word);
+    auto offset = static_cast<off_t>(index * bytes);
+    auto data = reinterpret_cast<char *>(record);
+    std::size_t done = 0;
+    while (done < bytes) {
+        auto n = ::pread(fd, data + done, bytes - done, offset + static_cast<off_t>(done));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n <= 0) {
+            throw ioError("Cannot read", path);
+        }
+
+        done += static_cast<std::size_t>(n);
+    }
+}
+
+bool RunReader::refill() {
+    auto data = reinterpret_cast<char *>(buffer.data());
+    const std::size_t capacity = buffer.size() * sizeof(Word);
+    std::size_t filled = 0;
+    while (filled < capacity) {
+        auto n = ::read(fd, data + filled, capacity - filled);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n < 0) {
+            throw ioError("Cannot read", path);
+        }
+
+        if (n == 0) {
+            break;
+        }
+
+        filled += static_cast<std::size_t>(n);
+    }
+
+    pos = 0;
+    end = filled / (recordWords * sizeof(Word)) * recordWords;
+    return end > 0;
+}
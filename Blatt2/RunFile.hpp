@@ -0,0 +1,94 @@
+#ifndef BLATT2_RUNFILE_HPP
+#define BLATT2_RUNFILE_HPP
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Files of fixed size records of 64 bit words, used to keep search layers on disk. Both ends do their own buffering
+ * so that the records can be streamed with a few large reads and writes
+ */
+class RunWriter {
+public:
+    using Word = std::uint64_t;
+
+    /**
+     * Creates (or truncates) the file at path
+     * @param path
+     * @param recordWords number of words per record
+     * @throws std::runtime_error if the file cannot be created
+     */
+    RunWriter(const std::string &path, std::size_t recordWords);
+    RunWriter(RunWriter &&other) noexcept;
+    RunWriter(const RunWriter &) = delete;
+    auto operator=(const RunWriter &) -> RunWriter & = delete;
+    auto operator=(RunWriter &&) -> RunWriter & = delete;
+    ~RunWriter();
+
+    void write(const Word *record);
+
+    /**
+     * Writes the buffered records and closes the file
+     * @throws std::runtime_error on write errors
+     */
+    void close();
+
+    [[nodiscard]] auto size() const -> std::uint64_t;
+
+private:
+    void flush();
+
+    std::string path;
+    int fd;
+    std::size_t recordWords;
+    std::vector<Word> buffer;
+    std::uint64_t written = 0;
+};
+
+class RunReader {
+public:
+    using Word = std::uint64_t;
+
+    /**
+     * @param path
+     * @param recordWords number of words per record
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    RunReader(const std::string &path, std::size_t recordWords);
+    RunReader(RunReader &&other) noexcept;
+    RunReader(const RunReader &) = delete;
+    auto operator=(const RunReader &) -> RunReader & = delete;
+    auto operator=(RunReader &&) -> RunReader & = delete;
+    ~RunReader();
+
+    /**
+     * Advances to the next record
+     * @return false at the end of the file
+     */
+    bool next();
+
+    /**
+     * @return the current record, valid until the next call of next
+     */
+    [[nodiscard]] auto current() const -> const Word *;
+
+    /**
+     * Reads a single record without disturbing the stream position
+     * @param index
+     * @param record receives recordWords words
+     */
+    void readAt(std::uint64_t index, Word *record) const;
+
+private:
+    bool refill();
+
+    std::string path;
+    int fd;
+    std::size_t recordWords;
+    std::vector<Word> buffer;
+    std::size_t pos = 0;
+    std::size_t end = 0;
+    bool started = false;
+};
+
+#endif //BLATT2_RUNFILE_HPP
@@ -0,0 +1,46 @@
+#include "ShardedStateMap.hpp"
+#include <algorithm>
+#include <cassert>
+
+ShardedStateMap::ShardedStateMap(std::size_t numShards) {
+    assert(numShards > 0);
+    shards.reserve(numShards);
+    for (std::size_t i = 0; i < numShards; ++i) {
+        shards.emplace_back(std::make_unique<Shard>());
+    }
+}
+
+void ShardedStateMap::insert(std::vector<Entry> &batch) {
+    auto shardOf = [this](const Entry &e) { return e.first.getHash() % shards.size(); };
+    std::sort(batch.begin(), batch.end(), [&shardOf](const auto &a, const auto &b) {
+        return shardOf(a) < shardOf(b);
+    });
+
+    auto it = batch.begin();
+    while (it != batch.end()) {
+        auto &shard = *shards[shardOf(*it)];
+        std::lock_guard lock(shard.mutex);
+        const auto current = shardOf(*it);
+        for (; it != batch.end() && shardOf(*it) == current; ++it) {
+            auto [res, inserted] = shard.entries.emplace(std::move(it->first), it->second);
+            if (!inserted && it->second < res->second) {
+                res->second = it->second;
+            }
+        }
+    }
+
+    batch.clear();
+}
+
+auto ShardedStateMap::extract() -> std::vector<Entry> {
+    std::vector<Entry> ret;
+    for (auto &shard : shards) {
+        std::lock_guard lock(shard->mutex);
+        for (auto it = shard->entries.begin(); it != shard->entries.end();) {
+            auto node = shard->entries.extract(it++);
+            ret.emplace_back(std::move(node.key()), node.mapped());
+        }
+    }
+
+    return ret;
+}
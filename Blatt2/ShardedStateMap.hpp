@@ -0,0 +1,43 @@
+#ifndef BLATT2_SHARDEDSTATEMAP_HPP
+#define BLATT2_SHARDEDSTATEMAP_HPP
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <utility>
+#include <unordered_map>
+#include "State.hpp"
+
+/**
+ * Concurrent map from states to the smallest key they were inserted with. The states are distributed over
+ * independently locked shards by their zobrist hash
+ */
+class ShardedStateMap {
+public:
+    using Key = std::pair<std::size_t, std::size_t>;
+    using Entry = std::pair<State, Key>;
+
+    explicit ShardedStateMap(std::size_t numShards);
+
+    /**
+     * Inserts all entries of batch, keeping the smaller key for states that are already present. Entries of the
+     * same shard are inserted under a single lock. batch is cleared afterwards
+     * @param batch
+     */
+    void insert(std::vector<Entry> &batch);
+
+    /**
+     * Moves all entries out of the map
+     * @return entries in unspecified order
+     */
+    auto extract() -> std::vector<Entry>;
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<State, Key, State::Hash> entries;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+};
+
+#endif //BLATT2_SHARDEDSTATEMAP_HPP
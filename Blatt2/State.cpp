@@ -0,0 +1,50 @@
+#include "State.hpp"
+#include "Zobrist.hpp"
+#include <cassert>
+
+State::State(BitSet facts) : facts(std::move(facts)), hash(0) {
+    this->facts.forEach([this](FactId id) { hash ^= zobrist::key(id); });
+}
+
+State::State(BitSet facts, const Condition &goal) : State(std::move(facts)) {
+    unsatisfied = goal.countViolated(this->facts);
+}
+
+State::State(BitSet facts, std::uint64_t hash, std::size_t unsatisfied) : facts(std::move(facts)), hash(hash),
+    unsatisfied(unsatisfied) {}
+
+auto State::getFacts() const -> const BitSet & {
+    return facts;
+}
+
+auto State::getHash() const -> std::uint64_t {
+    return hash;
+}
+
+bool State::isSolutionOf(const Condition &target) const {
+    return target.satisfiedBy(facts);
+}
+
+auto State::getUnsatisfiedGoals() const -> std::size_t {
+    return unsatisfied;
+}
+
+bool State::isGoal() const {
+    assert(unsatisfied != Untracked);
+    return unsatisfied == 0;
+}
+
+void State::flip(std::size_t id) {
+    if (facts.test(id)) {
+        facts.reset(id);
+    } else {
+        facts.set(id);
+    }
+
+    hash ^= zobrist::key(id);
+    unsatisfied = Untracked;
+}
+
+bool State::operator==(const State &other) const {
+    return hash == other.hash && facts == other.facts;
+}
@@ -0,0 +1,77 @@
+#ifndef BLATT2_STATE_HPP
+#define BLATT2_STATE_HPP
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include "BitSet.hpp"
+#include "Condition.hpp"
+
+/**
+ * Complete state under closed world assumption: a fact is true iff its bit is set. A state can additionally track the
+ * number of literals of the task's target it violates, which makes the goal test O(1) and serves as goal count
+ * heuristic
+ */
+class State {
+public:
+    struct Hash {
+        std::size_t operator()(const State &s) const {
+            return s.getHash();
+        }
+    };
+
+    static constexpr std::size_t Untracked = std::numeric_limits<std::size_t>::max();
+
+    explicit State(BitSet facts);
+
+    /**
+     * Tracks the violated literals of goal. Successors computed by Action::applyTo keep the counter up to date if the
+     * action was prepared for the same goal with Action::trackGoal
+     * @param facts
+     * @param goal
+     */
+    State(BitSet facts, const Condition &goal);
+
+    /**
+     * Used by Action::applyTo which updates the zobrist hash and the goal counter incrementally
+     * @param facts
+     * @param hash must be the zobrist hash of facts
+     * @param unsatisfied number of violated goal literals or Untracked
+     */
+    State(BitSet facts, std::uint64_t hash, std::size_t unsatisfied = Untracked);
+    [[nodiscard]] auto getFacts() const -> const BitSet &;
+    [[nodiscard]] auto getHash() const -> std::uint64_t;
+    [[nodiscard]] bool isSolutionOf(const Condition &target) const;
+
+    /**
+     * Number of violated goal literals (goal count heuristic)
+     * @return Untracked if the state does not track a goal
+     */
+    [[nodiscard]] auto getUnsatisfiedGoals() const -> std::size_t;
+
+    /**
+     * O(1) goal test for states that track the goal
+     * @return
+     */
+    [[nodiscard]] bool isGoal() const;
+
+    /**
+     * Toggles a single fact and updates the hash. Used by searches that modify one state in place, the state stops
+     * tracking the goal
+     * @param id
+     */
+    void flip(std::size_t id);
+
+    /**
+     * Compares the hashes first, the fact sets are only compared on a hash collision
+     * @param other
+     * @return
+     */
+    bool operator==(const State &other) const;
+
+private:
+    BitSet facts;
+    std::uint64_t hash;
+    std::size_t unsatisfied = Untracked;
+};
+
+#endif //BLATT2_STATE_HPP
@@ -0,0 +1,76 @@
+#include "SuccessorGenerator.hpp"
+#include <algorithm>
+#include <limits>
+
+SuccessorGenerator::SuccessorGenerator(const std::vector<Action> &actions, const State &start) : actions(actions),
+    watchedFacts(start.getFacts().size()), watchers(start.getFacts().size()) {
+    const auto numFacts = start.getFacts().size();
+    BitSet dynamicFacts(numFacts);
+    for (const auto &action : actions) {
+        dynamicFacts |= action.getAddEffects();
+        dynamicFacts |= action.getDelEffects();
+    }
+
+    BitSet staticTrue = start.getFacts();
+    staticTrue.subtract(dynamicFacts);
+    BitSet staticFalse(numFacts);
+    for (FactId f = 0; f < numFacts; ++f) {
+        if (!dynamicFacts.test(f) && !staticTrue.test(f)) {
+            staticFalse.set(f);
+        }
+    }
+
+    std::vector<std::size_t> occurrences(numFacts, 0);
+    for (const auto &action : actions) {
+        action.getPreconditions().getPositive().forEach([&](FactId f) { ++occurrences[f]; });
+    }
+
+    for (std::size_t a = 0; a < actions.size(); ++a) {
+        const auto &pre = actions[a].getPreconditions();
+        if (pre.getPositive().intersects(staticFalse) || pre.getNegative().intersects(staticTrue)) {
+            continue;
+        }
+
+        // watch the least common dynamic precondition to keep the lists short
+        auto watched = std::numeric_limits<FactId>::max();
+        pre.getPositive().forEach([&](FactId f) {
+            if (dynamicFacts.test(f) && (watched == std::numeric_limits<FactId>::max() ||
+                                         occurrences[f] < occurrences[watched])) {
+                watched = f;
+            }
+        });
+
+        if (watched == std::numeric_limits<FactId>::max()) {
+            unconditional.emplace_back(a);
+        } else {
+            watchedFacts.set(watched);
+            watchers[watched].emplace_back(a);
+        }
+    }
+}
+
+void SuccessorGenerator::getApplicable(const State &state, std::vector<std::size_t> &result) const {
+    result.clear();
+    for (auto a : unconditional) {
+        if (actions[a].applicable(state)) {
+            result.emplace_back(a);
+        }
+    }
+
+    const auto &words = state.getFacts().getWords();
+    const auto &watchedWords = watchedFacts.getWords();
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        auto w = words[i] & watchedWords[i];
+        while (w != 0) {
+            const auto f = i * BitSet::WordBits + static_cast<std::size_t>(std::countr_zero(w));
+            w &= w - 1;
+            for (auto a : watchers[f]) {
+                if (actions[a].applicable(state)) {
+                    result.emplace_back(a);
+                }
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+}
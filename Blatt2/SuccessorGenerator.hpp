@@ -0,0 +1,33 @@
+#ifndef BLATT2_SUCCESSORGENERATOR_HPP
+#define BLATT2_SUCCESSORGENERATOR_HPP
+#include <vector>
+#include <cstddef>
+#include "Action.hpp"
+#include "State.hpp"
+#include "BitSet.hpp"
+
+/**
+ * Index over the action preconditions that only yields candidates that can be applicable in a given state.
+ * Facts that are not changed by any action (static facts) keep the value they have in the start state. Actions with
+ * a violated static precondition are dropped entirely. Every remaining action watches one positive precondition on a
+ * non-static fact and is only checked if that fact is true. Actions without such a precondition are checked always.
+ */
+class SuccessorGenerator {
+public:
+    SuccessorGenerator(const std::vector<Action> &actions, const State &start);
+
+    /**
+     * Stores the indices of all actions applicable in state in ascending order (same order as scanning all actions)
+     * @param state
+     * @param result is cleared first
+     */
+    void getApplicable(const State &state, std::vector<std::size_t> &result) const;
+
+private:
+    const std::vector<Action> &actions;
+    BitSet watchedFacts;
+    std::vector<std::vector<std::size_t>> watchers;
+    std::vector<std::size_t> unconditional;
+};
+
+#endif //BLATT2_SUCCESSORGENERATOR_HPP
@@ -0,0 +1,195 @@
+#include "Task.hpp"
+#include "util.hpp"
+#include <cassert>
+
+namespace {
+    struct Literals {
+        std::vector<FactId> pos;
+        std::vector<FactId> neg;
+    };
+
+    /**
+     * Owns the literal arrays of a Domain parsed from text
+     */
+    struct ParsedDomain {
+        std::vector<std::uint32_t> literals;
+        std::vector<std::uint64_t> offsets = {0};
+        Domain domain;
+    };
+
+    auto parseLiterals(std::string_view spec, FactTable &facts) -> Literals {
+        util::Tokenizer parts(spec, ';');
+        std::string_view pos;
+        std::string_view neg;
+        parts.next(pos);
+        parts.next(neg);
+        assert(parts.remaining().empty());
+        Literals ret;
+        facts.internList(pos, ret.pos);
+        facts.internList(neg, ret.neg);
+        return ret;
+    }
+
+    void parseDomain(std::string_view text, ParsedDomain &parsed) {
+        FactTable facts;
+        std::vector<FactId> ids;
+        util::Tokenizer lines(text, '\n');
+        std::string_view line;
+        while (lines.next(line)) {
+            if (line.empty()) {
+                continue;
+            }
+
+            util::Tokenizer parts(line, ';');
+            std::string_view name;
+            parts.next(name);
+            parsed.domain.actionNames.emplace_back(name);
+            std::size_t numFields = 1;
+            for (std::size_t part = 0; part < Domain::NumParts; ++part) {
+                std::string_view field;
+                numFields += parts.next(field);
+                ids.clear();
+                facts.internList(field, ids);
+                parsed.literals.insert(parsed.literals.end(), ids.begin(), ids.end());
+                parsed.offsets.emplace_back(parsed.literals.size());
+            }
+
+            assert(numFields >= 4 && parts.remaining().empty());
+        }
+
+        parsed.domain.factNames.reserve(facts.size());
+        for (FactId f = 0; f < facts.size(); ++f) {
+            parsed.domain.factNames.emplace_back(facts.getName(f));
+        }
+
+        parsed.domain.literals = parsed.literals;
+        parsed.domain.offsets = parsed.offsets;
+    }
+
+    template<typename IDS>
+    auto toBitSet(const IDS &ids, std::size_t size) -> BitSet {
+        BitSet ret(size);
+        for (auto id : ids) {
+            ret.set(id);
+        }
+
+        return ret;
+    }
+
+    auto toFacts(const Literals &literals, std::size_t size) -> BitSet {
+        BitSet facts = toBitSet(literals.pos, size);
+        for (auto id : literals.neg) {
+            facts.reset(id);
+        }
+
+        return facts;
+    }
+
+    auto toCondition(const Literals &literals, std::size_t size) -> Condition {
+        return Condition(toBitSet(literals.pos, size), toBitSet(literals.neg, size));
+    }
+}
+
+Task::Task(InputBuffer input, std::optional<InputBuffer> cacheFile, std::vector<std::string_view> header,
+           FactTable facts, State start, Condition target, std::vector<Action> actions) : input(std::move(input)),
+           cacheFile(std::move(cacheFile)), header(std::move(header)), facts(std::move(facts)),
+           start(std::move(start)), target(std::move(target)), actions(std::move(actions)) {
+    for (std::size_t i = 0; i < this->actions.size(); ++i) {
+        actionIds.emplace(this->actions[i].getName(), i);
+    }
+}
+
+auto Task::parse(InputBuffer input, std::size_t headerLines) -> Task {
+    util::Tokenizer lines(input.getText(), '\n');
+    std::vector<std::string_view> header(headerLines);
+    for (auto &line : header) {
+        lines.next(line);
+    }
+
+    std::string_view startLine;
+    std::string_view targetLine;
+    lines.next(startLine);
+    lines.next(targetLine);
+    const auto domainText = lines.remaining();
+    const TaskCache cache(domainText);
+    auto cached = cache.load();
+    std::optional<InputBuffer> cacheFile;
+    ParsedDomain parsed;
+    const Domain *domain;
+    if (cached.has_value()) {
+        cacheFile.emplace(std::move(cached->first));
+        domain = &cached->second;
+    } else {
+        parseDomain(domainText, parsed);
+        cache.store(parsed.domain);
+        domain = &parsed.domain;
+    }
+
+    // domain facts first, so that their ids match the (cached) domain
+    FactTable facts;
+    for (auto name : domain->factNames) {
+        facts.intern(name);
+    }
+
+    const auto startSpec = parseLiterals(startLine, facts);
+    const auto targetSpec = parseLiterals(targetLine, facts);
+    const auto numFacts = facts.size();
+    std::vector<Action> actions;
+    actions.reserve(domain->actionNames.size());
+    for (std::size_t a = 0; a < domain->actionNames.size(); ++a) {
+        actions.emplace_back(domain->actionNames[a],
+                             Condition(toBitSet(domain->getLiterals(a, Domain::PrePos), numFacts),
+                                       toBitSet(domain->getLiterals(a, Domain::PreNeg), numFacts)),
+                             toBitSet(domain->getLiterals(a, Domain::Add), numFacts),
+                             toBitSet(domain->getLiterals(a, Domain::Del), numFacts));
+    }
+
+    auto target = toCondition(targetSpec, numFacts);
+    for (auto &action : actions) {
+        action.trackGoal(target);
+    }
+
+    State start(toFacts(startSpec, numFacts), target);
+    return Task(std::move(input), std::move(cacheFile), std::move(header), std::move(facts), std::move(start),
+                std::move(target), std::move(actions));
+}
+
+auto Task::getHeader(std::size_t i) const -> std::string_view {
+    assert(i < header.size());
+    return header[i];
+}
+
+auto Task::getFacts() const -> const FactTable & {
+    return facts;
+}
+
+auto Task::getStart() const -> const State & {
+    return start;
+}
+
+auto Task::getTarget() const -> const Condition & {
+    return target;
+}
+
+auto Task::getActions() const -> const std::vector<Action> & {
+    return actions;
+}
+
+auto Task::findAction(std::string_view name) const -> std::optional<std::size_t> {
+    auto res = actionIds.find(name);
+    if (res == actionIds.end()) {
+        return {};
+    }
+
+    return res->second;
+}
+
+void Task::printPlan(std::ostream &out, const std::vector<std::size_t> &plan) const {
+    for (std::size_t i = 0; i < plan.size(); ++i) {
+        if (i != 0) {
+            out << ",";
+        }
+
+        out << actions[plan[i]].getName();
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef BLATT2_TASK_HPP
+#define BLATT2_TASK_HPP
+#include <ostream>
+#include <vector>
+#include <string_view>
+#include <optional>
+#include <unordered_map>
+#include "InputBuffer.hpp"
+#include "TaskCache.hpp"
+#include "FactTable.hpp"
+#include "State.hpp"
+#include "Condition.hpp"
+#include "Action.hpp"
+
+/**
+ * Planning task in the format
+ * pos;neg                  (start state)
+ * pos;neg                  (target)
+ * name;pre+;pre-;add;del   (one line per action)
+ * The task owns its input and its cache file, all names are views into them
+ */
+class Task {
+public:
+    /**
+     * Parses the task in a single pass over the input without copying any names. All fact names are interned
+     * first so that every bit set has the final size. The action lines are taken from the TaskCache if they did not
+     * change since the last run, otherwise they are parsed and the cache is written
+     * @param input
+     * @param headerLines number of tool specific lines in front of the start state (e.g. the action name for
+     * Applicable), available via getHeader
+     * @return
+     */
+    static auto parse(InputBuffer input, std::size_t headerLines = 0) -> Task;
+
+    [[nodiscard]] auto getHeader(std::size_t i) const -> std::string_view;
+    [[nodiscard]] auto getFacts() const -> const FactTable &;
+    [[nodiscard]] auto getStart() const -> const State &;
+    [[nodiscard]] auto getTarget() const -> const Condition &;
+    [[nodiscard]] auto getActions() const -> const std::vector<Action> &;
+    [[nodiscard]] auto findAction(std::string_view name) const -> std::optional<std::size_t>;
+
+    /**
+     * Prints the names of the given actions separated by ','
+     * @param out
+     * @param plan action indices
+     */
+    void printPlan(std::ostream &out, const std::vector<std::size_t> &plan) const;
+
+private:
+    Task(InputBuffer input, std::optional<InputBuffer> cacheFile, std::vector<std::string_view> header,
+         FactTable facts, State start, Condition target, std::vector<Action> actions);
+    InputBuffer input;
+    std::optional<InputBuffer> cacheFile;
+    std::vector<std::string_view> header;
+    FactTable facts;
+    State start;
+    Condition target;
+    std::vector<Action> actions;
+    std::unordered_map<std::string_view, std::size_t> actionIds;
+};
+
+#endif //BLATT2_TASK_HPP
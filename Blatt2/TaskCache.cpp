@@ -0,0 +1,260 @@
+#include "TaskCache.hpp"
+#include <array>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <unistd.h>
+
+namespace {
+    constexpr char Magic[8] = {'S', 'T', 'R', 'I', 'P', 'S', 'T', 'K'};
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t endianness;
+        std::uint64_t sourceHash;
+        std::uint64_t sourceSize;
+        std::uint64_t numFacts;
+        std::uint64_t numActions;
+        std::uint64_t numLiterals;
+        std::uint64_t namesSize;
+    };
+
+    constexpr std::uint32_t EndiannessMark = 0x01020304;
+
+    auto hashText(std::string_view text) -> std::uint64_t {
+        std::uint64_t h = 0x84222325cbf29ce4ull ^ text.size();
+        auto mix = [&h](std::uint64_t w) {
+            h ^= w;
+            h *= 0x9e3779b97f4a7c15ull;
+            h ^= h >> 29u;
+        };
+
+        std::size_t i = 0;
+        for (; i + 8 <= text.size(); i += 8) {
+            std::uint64_t w;
+            std::memcpy(&w, text.data() + i, 8);
+            mix(w);
+        }
+
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, text.data() + i, text.size() - i);
+        mix(tail);
+        return h;
+    }
+
+    auto cacheDirectory() -> std::optional<std::filesystem::path> {
+        const char *dir = std::getenv("STRIPS_CACHE_DIR");
+        if (dir != nullptr) {
+            if (*dir == '\0') {
+                return {};
+            }
+
+            return std::filesystem::path(dir);
+        }
+
+        std::error_code error;
+        auto tmp = std::filesystem::temp_directory_path(error);
+        if (error) {
+            return {};
+        }
+
+        return tmp / "strips-cache";
+    }
+
+    /**
+     * Layout: Header, fact name offsets (numFacts + 1), action name offsets (numActions + 1), literal offsets
+     * (numActions * NumParts + 1), literals (numLiterals, 32 bit), names, source (sourceSize). All name offsets are
+     * relative to the start of the names block
+     */
+    auto sectionSizes(const Header &h) -> std::array<std::size_t, 6> {
+        return {(h.numFacts + 1) * sizeof(std::uint64_t), (h.numActions + 1) * sizeof(std::uint64_t),
+                (h.numActions * Domain::NumParts + 1) * sizeof(std::uint64_t),
+                h.numLiterals * sizeof(std::uint32_t), h.namesSize, h.sourceSize};
+    }
+
+    /**
+     * @param offsets
+     * @param count number of offsets
+     * @param first required first offset
+     * @param limit
+     * @return true if the offsets start at first, never decrease and do not exceed limit
+     */
+    bool validOffsets(const std::uint64_t *offsets, std::size_t count, std::uint64_t first, std::uint64_t limit) {
+        if (count == 0 || offsets[0] != first) {
+            return false;
+        }
+
+        for (std::size_t i = 1; i < count; ++i) {
+            if (offsets[i] < offsets[i - 1]) {
+                return false;
+            }
+        }
+
+        return offsets[count - 1] <= limit;
+    }
+}
+
+TaskCache::TaskCache(std::string_view domainText) {
+    if (domainText.size() < MinSourceSize) {
+        return;
+    }
+
+    auto dir = cacheDirectory();
+    if (!dir.has_value()) {
+        return;
+    }
+
+    source = domainText;
+    sourceHash = hashText(domainText);
+    sourceSize = domainText.size();
+    std::stringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << sourceHash << ".v" << std::dec << Version << ".task";
+    path = *dir / name.str();
+    enabled = true;
+}
+
+auto TaskCache::load() const -> std::optional<std::pair<InputBuffer, Domain>> {
+    if (!enabled || !std::filesystem::exists(path)) {
+        return {};
+    }
+
+    try {
+        auto file = InputBuffer::open(path.string());
+        auto data = file.getText();
+        Header header{};
+        if (data.size() < sizeof(Header)) {
+            return {};
+        }
+
+        std::memcpy(&header, data.data(), sizeof(Header));
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version ||
+            header.endianness != EndiannessMark || header.sourceHash != sourceHash ||
+            header.sourceSize != sourceSize) {
+            return {};
+        }
+
+        // every entry takes at least one byte, larger counts would overflow the section sizes
+        if (header.numFacts >= data.size() || header.numActions >= data.size() ||
+            header.numLiterals >= data.size() || header.namesSize >= data.size()) {
+            return {};
+        }
+
+        const auto sizes = sectionSizes(header);
+        std::size_t total = sizeof(Header);
+        for (auto s : sizes) {
+            total += s;
+        }
+
+        if (data.size() != total) {
+            return {};
+        }
+
+        const char *pos = data.data() + sizeof(Header);
+        auto factOffsets = reinterpret_cast<const std::uint64_t *>(pos);
+        pos += sizes[0];
+        auto actionOffsets = reinterpret_cast<const std::uint64_t *>(pos);
+        pos += sizes[1];
+        auto literalOffsets = reinterpret_cast<const std::uint64_t *>(pos);
+        pos += sizes[2];
+        auto literals = reinterpret_cast<const std::uint32_t *>(pos);
+        pos += sizes[3];
+        const char *names = pos;
+        pos += sizes[4];
+        if (std::memcmp(pos, source.data(), source.size()) != 0) {
+            return {};
+        }
+
+        const auto numOffsets = header.numActions * Domain::NumParts + 1;
+        if (!validOffsets(factOffsets, header.numFacts + 1, 0, header.namesSize) ||
+            !validOffsets(actionOffsets, header.numActions + 1, factOffsets[header.numFacts], header.namesSize) ||
+            !validOffsets(literalOffsets, numOffsets, 0, header.numLiterals) ||
+            literalOffsets[numOffsets - 1] != header.numLiterals) {
+            return {};
+        }
+
+        for (std::size_t i = 0; i < header.numLiterals; ++i) {
+            if (literals[i] >= header.numFacts) {
+                return {};
+            }
+        }
+
+        Domain domain;
+        domain.factNames.reserve(header.numFacts);
+        for (std::size_t i = 0; i < header.numFacts; ++i) {
+            domain.factNames.emplace_back(names + factOffsets[i], factOffsets[i + 1] - factOffsets[i]);
+        }
+
+        domain.actionNames.reserve(header.numActions);
+        for (std::size_t i = 0; i < header.numActions; ++i) {
+            domain.actionNames.emplace_back(names + actionOffsets[i], actionOffsets[i + 1] - actionOffsets[i]);
+        }
+
+        domain.literals = {literals, header.numLiterals};
+        domain.offsets = {literalOffsets, numOffsets};
+        return std::pair(std::move(file), std::move(domain));
+    } catch (const std::exception &) {
+        return {};
+    }
+}
+
+void TaskCache::store(const Domain &domain) const {
+    if (!enabled) {
+        return;
+    }
+
+    std::vector<std::uint64_t> factOffsets = {0};
+    std::vector<std::uint64_t> actionOffsets;
+    std::string names;
+    for (auto name : domain.factNames) {
+        names.append(name);
+        factOffsets.emplace_back(names.size());
+    }
+
+    actionOffsets.emplace_back(names.size());
+    for (auto name : domain.actionNames) {
+        names.append(name);
+        actionOffsets.emplace_back(names.size());
+    }
+
+    Header header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.endianness = EndiannessMark;
+    header.sourceHash = sourceHash;
+    header.sourceSize = sourceSize;
+    header.numFacts = domain.factNames.size();
+    header.numActions = domain.actionNames.size();
+    header.numLiterals = domain.literals.size();
+    header.namesSize = names.size();
+
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    auto tmpPath = path;
+    tmpPath += ".tmp" + std::to_string(::getpid());
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        auto write = [&out](const void *data, std::size_t size) {
+            out.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+        };
+
+        write(&header, sizeof(header));
+        write(factOffsets.data(), factOffsets.size() * sizeof(std::uint64_t));
+        write(actionOffsets.data(), actionOffsets.size() * sizeof(std::uint64_t));
+        write(domain.offsets.data(), domain.offsets.size() * sizeof(std::uint64_t));
+        write(domain.literals.data(), domain.literals.size() * sizeof(std::uint32_t));
+        write(names.data(), names.size());
+        write(source.data(), source.size());
+        if (!out) {
+            std::filesystem::remove(tmpPath, error);
+            return;
+        }
+    }
+
+    std::filesystem::rename(tmpPath, path, error);
+    if (error) {
+        std::filesystem::remove(tmpPath, error);
+    }
+}
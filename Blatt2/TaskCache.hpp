@@ -0,0 +1,73 @@
+#ifndef BLATT2_TASKCACHE_HPP
+#define BLATT2_TASKCACHE_HPP
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <optional>
+#include <utility>
+#include <filesystem>
+#include "InputBuffer.hpp"
+
+/**
+ * Grounded action part of a task. Facts are numbered in order of their first occurrence in the action lines, so the
+ * numbering does not depend on the start state or the target
+ */
+struct Domain {
+    enum Part {
+        PrePos, PreNeg, Add, Del, NumParts
+    };
+
+    std::vector<std::string_view> factNames;
+    std::vector<std::string_view> actionNames;
+    /**
+     * literals of part p of action a: literals[offsets[a * NumParts + p], offsets[a * NumParts + p + 1])
+     */
+    std::span<const std::uint32_t> literals;
+    std::span<const std::uint64_t> offsets;
+
+    [[nodiscard]] auto getLiterals(std::size_t action, Part part) const -> std::span<const std::uint32_t> {
+        const auto i = action * NumParts + part;
+        return literals.subspan(offsets[i], offsets[i + 1] - offsets[i]);
+    }
+};
+
+/**
+ * Versioned binary copy of a Domain next to its source. The cache file is named after a hash of the action lines and
+ * additionally stores the action lines themselves, so it is only used if they are byte for byte the same. All counts
+ * and offsets of the file are checked against its size before it is used, a corrupt or truncated file is ignored like
+ * a missing one. The planners are
+ * typically run with the same actions but different start states, which is why the start state and the target are
+ * not part of the cache.
+ * The cache directory is $STRIPS_CACHE_DIR or <tmp>/strips-cache, an empty STRIPS_CACHE_DIR disables the cache.
+ * Domains smaller than MinSourceSize are not cached because parsing them is faster than checking the cache
+ */
+class TaskCache {
+public:
+    static constexpr std::uint32_t Version = 2;
+    static constexpr std::size_t MinSourceSize = 1 << 16;
+
+    explicit TaskCache(std::string_view domainText);
+
+    /**
+     * Maps the cache file if it is valid for the domain text
+     * @return the mapped file and the domain pointing into it
+     */
+    [[nodiscard]] auto load() const -> std::optional<std::pair<InputBuffer, Domain>>;
+
+    /**
+     * Writes the cache file. Errors are ignored, the file is written to a temporary name and then renamed so that
+     * concurrent planners never see a partial file
+     * @param domain
+     */
+    void store(const Domain &domain) const;
+
+private:
+    bool enabled = false;
+    std::string_view source;
+    std::uint64_t sourceHash = 0;
+    std::uint64_t sourceSize = 0;
+    std::filesystem::path path;
+};
+
+#endif //BLATT2_TASKCACHE_HPP
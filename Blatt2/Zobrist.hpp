@@ -0,0 +1,21 @@
+#ifndef BLATT2_ZOBRIST_HPP
+#define BLATT2_ZOBRIST_HPP
+#include <cstdint>
+#include "FactTable.hpp"
+
+namespace zobrist {
+    /**
+     * Pseudo random 64 bit key of a fact (splitmix64 of the id). The key of a state is the xor of the keys of all
+     * true facts, so it can be updated in O(1) per changed fact
+     * @param id
+     * @return
+     */
+    inline auto key(FactId id) -> std::uint64_t {
+        std::uint64_t z = static_cast<std::uint64_t>(id) + 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27u)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31u);
+    }
+}
+
+#endif //BLATT2_ZOBRIST_HPP
@@ -0,0 +1,171 @@
+#include <iostream>
+#include <string>
+#include <array>
+#include <vector>
+#include <optional>
+#include <cassert>
+#include <unistd.h>
+#include "Task.hpp"
+#include "LineReader.hpp"
+#include "util.hpp"
+
+/*
+ * Batch version of Applicable. The task (in the usual format, start state and target are ignored) is loaded once from
+ * the file given as argument. Queries are read from stdin as pairs of lines
+ * actionName
+ * pos;neg          (state)
+ * and answered with one line Ja/Nein each (Fehler for unknown actions). Facts of a query state that do not occur in
+ * the task cannot influence applicability and are skipped.
+ * The queries are answered in blocks of BlockSize. The states of a block are stored transposed, one word per fact
+ * with one bit per query, so the preconditions of an action are tested against all queries of the block that ask for
+ * it with one word operation per literal. Only the facts set by the block are reset afterwards.
+ */
+
+constexpr std::size_t FlushSize = 1 << 16;
+constexpr std::size_t BlockSize = BitSet::WordBits;
+
+class QueryBlock {
+public:
+    explicit QueryBlock(const Task &task) : task(task), literalOffsets{0}, truth(task.getFacts().size(), 0),
+        users(task.getActions().size(), 0) {
+        for (const auto &action : task.getActions()) {
+            action.getPreconditions().getPositive().forEach([this](FactId f) { literals.push_back({f, true}); });
+            action.getPreconditions().getNegative().forEach([this](FactId f) { literals.push_back({f, false}); });
+            literalOffsets.emplace_back(literals.size());
+        }
+    }
+
+    [[nodiscard]] bool full() const {
+        return size == BlockSize;
+    }
+
+    /**
+     * @param action index of the action, empty if it is unknown
+     * @param stateLine pos;neg
+     */
+    void add(std::optional<std::size_t> action, std::string_view stateLine) {
+        const auto bit = BitSet::Word(1) << size;
+        actionOf[size++] = action;
+        if (!action.has_value()) {
+            return;
+        }
+
+        if (users[*action] == 0) {
+            used.emplace_back(*action);
+        }
+
+        users[*action] |= bit;
+        util::Tokenizer posNeg(stateLine, ';');
+        std::string_view pos;
+        std::string_view neg;
+        posNeg.next(pos);
+        posNeg.next(neg);
+        forEachFact(pos, [this, bit](FactId f) {
+            truth[f] |= bit;
+            touched.emplace_back(f);
+        });
+        forEachFact(neg, [this, bit](FactId f) {
+            truth[f] &= ~bit;
+        });
+    }
+
+    /**
+     * Appends the answers of the block in query order and empties the block
+     * @param answers
+     */
+    void answer(std::string &answers) {
+        for (auto a : used) {
+            auto applicable = users[a];
+            for (auto l = literalOffsets[a]; l < literalOffsets[a + 1] && applicable != 0; ++l) {
+                applicable &= literals[l].truthVal ? truth[literals[l].fact] : ~truth[literals[l].fact];
+            }
+
+            users[a] = applicable;
+        }
+
+        for (std::size_t q = 0; q < size; ++q) {
+            if (!actionOf[q].has_value()) {
+                answers.append("Fehler\n");
+            } else {
+                answers.append((users[*actionOf[q]] >> q) & 1u ? "Ja\n" : "Nein\n");
+            }
+        }
+
+        for (auto a : used) {
+            users[a] = 0;
+        }
+
+        for (auto f : touched) {
+            truth[f] = 0;
+        }
+
+        used.clear();
+        touched.clear();
+        size = 0;
+    }
+
+private:
+    template<typename FUN>
+    void forEachFact(std::string_view list, FUN &&fun) const {
+        util::Tokenizer names(list, ',');
+        std::string_view name;
+        while (names.next(name)) {
+            if (auto id = task.getFacts().find(name)) {
+                fun(*id);
+            }
+        }
+    }
+
+    struct Literal {
+        FactId fact;
+        bool truthVal;
+    };
+
+    const Task &task;
+    // preconditions of action a: literals[literalOffsets[a], literalOffsets[a + 1])
+    std::vector<Literal> literals;
+    std::vector<std::size_t> literalOffsets;
+    // bit q of truth[f] is the value of fact f in the state of query q
+    std::vector<BitSet::Word> truth;
+    // bit q of users[a] is set if query q asks for action a, after answer: if the action is applicable
+    std::vector<BitSet::Word> users;
+    std::vector<std::size_t> used;
+    std::vector<FactId> touched;
+    std::array<std::optional<std::size_t>, BlockSize> actionOf;
+    std::size_t size = 0;
+};
+
+int main(int argc, char **argv) {
+    assert(argc == 2);
+    const auto task = Task::parse(InputBuffer::open(argv[1]));
+    LineReader queries(STDIN_FILENO);
+    QueryBlock block(task);
+    std::string answers;
+    std::string_view actionName;
+    std::string_view stateLine;
+    while (queries.next(actionName)) {
+        const auto action = task.findAction(actionName);
+        if (!action.has_value()) {
+            std::cerr << "Action " << actionName << " is not in problem specification!" << std::endl;
+        }
+
+        if (!queries.next(stateLine)) {
+            stateLine = {};
+        }
+
+        block.add(action, stateLine);
+        if (block.full()) {
+            block.answer(answers);
+        }
+
+        if (answers.size() >= FlushSize) {
+            std::cout.write(answers.data(), static_cast<std::streamsize>(answers.size()));
+            answers.clear();
+        }
+    }
+
+    block.answer(answers);
+    std::cout.write(answers.data(), static_cast<std::streamsize>(answers.size()));
+    std::cout.flush();
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include <iostream>
+#include <string>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>
+#include "FactTable.hpp"
+#include "BitSet.hpp"
+#include "LineReader.hpp"
+#include "util.hpp"
+
+/*
+ * Batch version of GoalTest. Queries are read from stdin as pairs of lines
+ * pos;neg          (state)
+ * pos;neg          (target)
+ * and answered with one line Ja/Nein each. Fact names are interned once over the whole stream, the lines themselves
+ * are only valid until the next read, so every new name is copied exactly once. A query only touches the bits of its
+ * own facts in two reused masks, so it costs time in the length of its lines and does not allocate.
+ */
+
+constexpr std::size_t FlushSize = 1 << 16;
+
+class OwningFactTable {
+public:
+    void internSpec(std::string_view spec, std::vector<FactId> &pos, std::vector<FactId> &neg) {
+        util::Tokenizer posNeg(spec, ';');
+        std::string_view posList;
+        std::string_view negList;
+        posNeg.next(posList);
+        posNeg.next(negList);
+        pos.clear();
+        neg.clear();
+        internList(posList, pos);
+        internList(negList, neg);
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t {
+        return facts.size();
+    }
+
+private:
+    void internList(std::string_view list, std::vector<FactId> &ids) {
+        util::Tokenizer tokens(list, ',');
+        std::string_view name;
+        while (tokens.next(name)) {
+            if (name.empty()) {
+                continue;
+            }
+
+            auto id = facts.find(name);
+            if (!id.has_value()) {
+                id = facts.intern(names.emplace_back(name));
+            }
+
+            ids.emplace_back(*id);
+        }
+    }
+
+    std::deque<std::string> names;
+    FactTable facts;
+};
+
+/**
+ * Grows both masks to hold at least size facts. The capacity doubles, so the masks are reallocated a logarithmic number
+ * of times over the whole stream. New masks are empty, callers only grow them between queries
+ */
+void reserve(BitSet &state, BitSet &negative, std::size_t size) {
+    if (size <= state.size()) {
+        return;
+    }
+
+    const auto capacity = std::max(size, 2 * state.size());
+    state = BitSet(capacity);
+    negative = BitSet(capacity);
+}
+
+int main() {
+    LineReader queries(STDIN_FILENO);
+    OwningFactTable facts;
+    std::vector<FactId> statePos, stateNeg, targetPos, targetNeg;
+    // reused over all queries, only the bits of the current query are set
+    BitSet state;
+    BitSet negative;
+    std::string answers;
+    std::string_view line;
+    while (queries.next(line)) {
+        facts.internSpec(line, statePos, stateNeg);
+        if (!queries.next(line)) {
+            line = {};
+        }
+
+        facts.internSpec(line, targetPos, targetNeg);
+        reserve(state, negative, facts.size());
+        // the state holds its positive facts unless they are negative as well, a target fact that is positive and
+        // negative counts as negative (see Condition)
+        for (auto id : statePos) {
+            state.set(id);
+        }
+
+        for (auto id : stateNeg) {
+            state.reset(id);
+        }
+
+        for (auto id : targetNeg) {
+            negative.set(id);
+        }
+
+        const bool solution = std::all_of(targetPos.begin(), targetPos.end(), [&](FactId id) {
+            return negative.test(id) || state.test(id);
+        }) && std::none_of(targetNeg.begin(), targetNeg.end(), [&](FactId id) {
+            return state.test(id);
+        });
+        answers.append(solution ? "Ja\n" : "Nein\n");
+        for (auto id : statePos) {
+            state.reset(id);
+        }
+
+        for (auto id : targetNeg) {
+            negative.reset(id);
+        }
+
+        if (answers.size() >= FlushSize) {
+            std::cout.write(answers.data(), static_cast<std::streamsize>(answers.size()));
+            answers.clear();
+        }
+    }
+
+    std::cout.write(answers.data(), static_cast<std::streamsize>(answers.size()));
+    std::cout.flush();
+    return 0;
+}
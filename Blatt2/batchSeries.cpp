@@ -0,0 +1,198 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <unordered_map>
+#include <unistd.h>
+#include "Task.hpp"
+#include "LineReader.hpp"
+#include "util.hpp"
+
+/*
+ * Batch version of Series. The task is loaded once from the file given as argument, the candidate plans are read from
+ * stdin, one comma separated action sequence per line, and every plan is answered with one line
+ * Nichtanwendbar/Anwendbar/Ziel (Fehler if it contains an unknown action) in input order.
+ * All plans are inserted into a trie so that a common prefix is simulated only once. The upper levels of the trie are
+ * expanded sequentially until there are enough independent subtrees, which are then simulated depth first by a pool
+ * of workers. A worker keeps one state per depth, so a subtree only needs memory proportional to its height.
+ */
+
+constexpr std::size_t SubtreesPerThread = 8;
+
+enum class Result : unsigned char {
+    NotApplicable, Applicable, Goal
+};
+
+struct TrieNode {
+    std::size_t action;
+    std::vector<std::size_t> children;
+};
+
+struct Subtree {
+    std::size_t node;
+    std::size_t depth;
+    bool failed;
+};
+
+class PlanTrie {
+public:
+    explicit PlanTrie(std::size_t numActions) : numActions(numActions), nodes(1) {}
+
+    auto child(std::size_t node, std::size_t action) -> std::size_t {
+        auto [it, inserted] = edges.emplace(node * numActions + action, nodes.size());
+        if (inserted) {
+            nodes[node].children.emplace_back(nodes.size());
+            nodes.push_back({action, {}});
+        }
+
+        return it->second;
+    }
+
+    [[nodiscard]] auto operator[](std::size_t node) const -> const TrieNode & {
+        return nodes[node];
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t {
+        return nodes.size();
+    }
+
+private:
+    std::size_t numActions;
+    std::vector<TrieNode> nodes;
+    std::unordered_map<std::size_t, std::size_t> edges;
+};
+
+/**
+ * Applies the action of node to states[depth - 1] and stores the outcome in results and states[depth]
+ * @return false if the action was not applicable or an ancestor already failed
+ */
+bool simulate(const Task &task, const PlanTrie &trie, std::size_t node, std::size_t depth, bool failed,
+              std::vector<State> &states, std::vector<Result> &results) {
+    const auto &action = task.getActions()[trie[node].action];
+    if (failed || !action.applicable(states[depth - 1])) {
+        results[node] = Result::NotApplicable;
+        return false;
+    }
+
+    if (states.size() <= depth) {
+        states.emplace_back(action.applyTo(states[depth - 1]));
+    } else {
+        states[depth] = action.applyTo(states[depth - 1]);
+    }
+
+    results[node] = states[depth].isGoal() ? Result::Goal : Result::Applicable;
+    return true;
+}
+
+int main(int argc, char **argv) {
+    assert(argc == 2);
+    const auto task = Task::parse(InputBuffer::open(argv[1]));
+    PlanTrie trie(std::max<std::size_t>(task.getActions().size(), 1));
+    constexpr auto Unknown = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> planEnds;
+    LineReader plans(STDIN_FILENO);
+    std::string_view line;
+    while (plans.next(line)) {
+        util::Tokenizer actionNames(line, ',');
+        std::string_view name;
+        std::size_t node = 0;
+        while (node != Unknown && actionNames.next(name)) {
+            auto res = task.findAction(name);
+            if (res.has_value()) {
+                node = trie.child(node, *res);
+            } else {
+                std::cerr << "Action " << name << " is not in problem specification!" << std::endl;
+                node = Unknown;
+            }
+        }
+
+        planEnds.emplace_back(node);
+    }
+
+    std::vector<Result> results(trie.size());
+    results[0] = task.getStart().isGoal() ? Result::Goal : Result::Applicable;
+
+    // breadth first over the upper levels until the subtrees can be distributed
+    const auto numThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::pair<Subtree, State>> subtrees = {{{0, 0, false}, task.getStart()}};
+    std::vector<State> states;
+    while (subtrees.size() < numThreads * SubtreesPerThread) {
+        std::vector<std::pair<Subtree, State>> next;
+        for (auto &[subtree, state] : subtrees) {
+            states.clear();
+            states.emplace_back(std::move(state));
+            for (auto c : trie[subtree.node].children) {
+                bool ok = simulate(task, trie, c, 1, subtree.failed, states, results);
+                next.push_back({{c, subtree.depth + 1, !ok}, ok ? states[1] : states[0]});
+            }
+        }
+
+        if (next.empty()) {
+            break;
+        }
+
+        subtrees = std::move(next);
+    }
+
+    std::atomic_size_t nextSubtree = 0;
+    auto worker = [&]() {
+        std::vector<State> workerStates;
+        std::vector<Subtree> stack;
+        std::size_t i;
+        while ((i = nextSubtree.fetch_add(1)) < subtrees.size()) {
+            const auto &[root, rootState] = subtrees[i];
+            workerStates.clear();
+            workerStates.emplace_back(rootState);
+            stack.clear();
+            for (auto c : trie[root.node].children) {
+                stack.push_back({c, 1, root.failed});
+            }
+
+            while (!stack.empty()) {
+                const auto current = stack.back();
+                stack.pop_back();
+                bool ok = simulate(task, trie, current.node, current.depth, current.failed, workerStates, results);
+                for (auto c : trie[current.node].children) {
+                    stack.push_back({c, current.depth + 1, !ok});
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int t = 1; t < std::min<std::size_t>(numThreads, subtrees.size()); ++t) {
+        workers.emplace_back(worker);
+    }
+
+    worker();
+    for (auto &w : workers) {
+        w.join();
+    }
+
+    std::string answers;
+    for (auto end : planEnds) {
+        if (end == Unknown) {
+            answers.append("Fehler\n");
+            continue;
+        }
+
+        switch (results[end]) {
+            case Result::NotApplicable:
+                answers.append("Nichtanwendbar\n");
+                break;
+            case Result::Applicable:
+                answers.append("Anwendbar\n");
+                break;
+            case Result::Goal:
+                answers.append("Ziel\n");
+                break;
+        }
+    }
+
+    std::cout.write(answers.data(), static_cast<std::streamsize>(answers.size()));
+    std::cout.flush();
+    return 0;
+}
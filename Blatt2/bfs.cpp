@@ -1,177 +1,46 @@
 #include <iostream>
-#include <unordered_map>
-#include <string>
 #include <vector>
-#include <sstream>
 #include <cassert>
-#include <algorithm>
-#include <fstream>
 #include <deque>
-
-using PredList = std::unordered_map<std::string, bool>;
-
-auto splitString(const std::string &string, char delimiter) -> std::vector<std::string> {
-    std::vector<std::string> ret;
-    std::stringstream tmp(string);
-    std::string part;
-    while (std::getline(tmp, part, delimiter)) {
-        ret.emplace_back(std::move(part));
-    }
-
-    return ret;
-}
-
-void appendPredicates(const std::string &predString, PredList &predicates, bool truthVal) {
-    auto preds = splitString(predString, ',');
-    for (const auto &p : preds) {
-        predicates[p] = truthVal;
-    }
-}
-
-class State {
-public:
-    explicit State(PredList preds) : predicates(std::move(preds)) {}
-    explicit State(const std::string &spec) {
-        auto posNegList = splitString(spec, ';');
-        if (posNegList.size() == 1) {
-            posNegList.emplace_back("");
-        }
-
-        assert(posNegList.size() == 2);
-        const auto &pos = posNegList.front();
-        const auto &neg = posNegList.back();
-        appendPredicates(pos, predicates, true);
-        appendPredicates(neg, predicates, false);
-    }
-
-    State(PredList preds, std::string actionSequence) : predicates(std::move(preds)),
-                                                        actionSequence(std::move(actionSequence)) {}
-
-    auto getPredicates() const -> const PredList & {
-        return predicates;
-    }
-
-    bool isSolutionOf(const State &state) const {
-        const auto &oPreds = state.getPredicates();
-        for (auto it = oPreds.cbegin(); it != predicates.end(); ++it) {
-            auto res = predicates.find(it->first);
-            assert(res != predicates.end());
-            if (it->second != res->second) {
-                return false;
-            }
-        }
-
-        return true;
-    }
-
-    auto getActionSequence() const -> const std::string & {
-        return actionSequence;
-    }
-
-private:
-    PredList predicates;
-    std::string actionSequence;
-};
-
-class Action {
-public:
-    explicit Action(const std::string &spec) {
-        auto specParts = splitString(spec, ';');
-        if (specParts.size() == 4) {
-            specParts.emplace_back("");
-        }
-
-        assert(specParts.size() == 5);
-        name = std::move(specParts.front());
-        appendPredicates(specParts[1], preconditions, true);
-        appendPredicates(specParts[2], preconditions, false);
-        appendPredicates(specParts[3], effects, true);
-        appendPredicates(specParts[4], effects, false);
-    }
-
-    auto getName() const -> const std::string & {
-        return name;
-    }
-
-    bool applicable(const State &state) const {
-#ifdef CPP20
-        return std::ranges::all_of(preconditions.begin(), preconditions.end(),
-                                   [&state] (const auto &elem) {
-            auto it = state.getPredicates().find(elem.first);
-            assert(it != state.getPredicates().end());
-            return it->second == elem.second;
-
-        });
-#else
-        const auto &statePreds = state.getPredicates();
-        for (auto it = preconditions.cbegin(); it != preconditions.end(); ++it) {
-            auto stateIt = statePreds.find(it->first);
-            assert(stateIt != statePreds.end());
-            if (it->second != stateIt->second) {
-                return false;
-            }
-        }
-
-        return true;
-#endif
-    }
-
-    State applyTo(const State &state) const {
-        assert(applicable(state));
-        PredList preds = state.getPredicates();
-        auto actionSeq = state.getActionSequence();
-        if (!actionSeq.empty()) {
-            actionSeq.append(",");
-        }
-
-        actionSeq.append(name);
-        for (const auto &effect : effects) {
-            preds[effect.first] = effect.second;
-        }
-
-        return State(std::move(preds), std::move(actionSeq));
-    }
-
-private:
-    std::string name;
-    PredList preconditions;
-    PredList effects;
-
-};
+#include "Task.hpp"
+#include "NodeArena.hpp"
+#include "SuccessorGenerator.hpp"
+#include "Statistics.hpp"
 
 int main(int argc, char **argv) {
+    Statistics stats("BFS");
+    stats.begin(Statistics::Phase::Parse);
 #ifdef DEBUG
     assert(argc == 2);
-    std::fstream in(argv[1]);
-    assert(in);
+    auto input = InputBuffer::open(argv[1]);
 #else
-    std::istream &in = std::cin;
+    auto input = InputBuffer::fromStdin();
 #endif
-    std::string line;
-    std::getline(in, line);
-    const State start(line);
-    line.clear();
-    getline(in, line);
-    const State target(line);
-    line.clear();
-    std::vector<Action> actions;
-    while (std::getline(in, line)) {
-        actions.emplace_back(std::move(line));
-    }
-
-    std::deque<State> fringe = {start};
+    const auto task = Task::parse(std::move(input));
+    const auto &actions = task.getActions();
+    stats.end(Statistics::Phase::Parse);
+    stats.begin(Statistics::Phase::Ground);
+    const SuccessorGenerator successors(actions, task.getStart());
+    stats.end(Statistics::Phase::Ground);
+    Statistics::Timer searchTimer(stats, Statistics::Phase::Search);
+    std::vector<std::size_t> applicable;
+    NodeArena nodes;
+    std::deque<std::pair<State, NodeId>> fringe = {{task.getStart(), nodes.emplace()}};
     while (!fringe.empty()) {
-        auto current = std::move(fringe.front());
+        stats.openSize(fringe.size());
+        auto [current, node] = std::move(fringe.front());
         fringe.pop_front();
-        if (current.isSolutionOf(target)) {
-            std::cout << current.getActionSequence() << std::endl;
+        if (current.isGoal()) {
+            task.printPlan(std::cout, nodes.extractPlan(node));
+            std::cout << std::endl;
             return 0;
         }
 
-        for(const auto &action : actions) {
-            if (action.applicable(current)) {
-                fringe.emplace_back(action.applyTo(current));
-            }
+        stats.expanded();
+        successors.getApplicable(current, applicable);
+        stats.generated(applicable.size());
+        for (auto a : applicable) {
+            fringe.emplace_back(actions[a].applyTo(current), nodes.emplace(node, a));
         }
     }
 
@@ -0,0 +1,261 @@
+#include <iostream>
+#include <vector>
+#include <array>
+#include <cassert>
+#include <algorithm>
+#include <optional>
+#include <limits>
+#include <unordered_map>
+#include "Task.hpp"
+#include "NodeArena.hpp"
+#include "SuccessorGenerator.hpp"
+
+/*
+ * Bidirectional breadth first search. The forward direction expands complete states starting at the start state,
+ * the backward direction regresses the (partial) target through the actions. A forward state s meets a backward
+ * condition c if s satisfies c.
+ * Always the direction with the smaller layer is expanded by one whole layer, so the first layer that produces a
+ * meeting contains a shortest plan. Only the two frontier layers have to be tested against each other: if a new
+ * condition regress(c, a) holds in an older forward state s, then c holds in a(s), which is a forward state of at most
+ * the depth of the frontier and was tested against c before; the same argument holds for a new forward state a(s)
+ * and an older condition c (either a is relevant for c and regress(c, a) holds in s or c already holds in s).
+ * The conditions of the backward frontier are kept in a MatchTree and every test is the lookup of a complete state in
+ * it: new forward states are looked up directly, after a backward layer the forward frontier is looked up in the tree
+ * of the new layer.
+ */
+
+/**
+ * Decision tree over conditions that finds the conditions a state satisfies. Every inner node tests a fact and has a
+ * child for the conditions that require the fact to be false, true or do not care about it, a lookup descends into
+ * the child of the value of the fact in the state and into the one that does not care. A leaf holds up to LeafSize
+ * conditions and is split on the fact that separates them best when it overflows
+ */
+class MatchTree {
+public:
+    MatchTree(std::size_t numFacts, const std::vector<Condition> &conditions) :
+            numFacts(numFacts), conditions(&conditions), nodes(1) {}
+
+    void insert(NodeId id) {
+        std::size_t n = 0;
+        while (!nodes[n].leaf) {
+            n = nodes[n].children[value((*conditions)[id], nodes[n].fact)];
+        }
+
+        nodes[n].conditions.emplace_back(id);
+        if (nodes[n].conditions.size() > LeafSize) {
+            split(n);
+        }
+    }
+
+    /**
+     * @param facts
+     * @return a condition that is satisfied by facts, if there is one
+     */
+    [[nodiscard]] auto find(const BitSet &facts) const -> std::optional<NodeId> {
+        stack.assign(1, 0);
+        while (!stack.empty()) {
+            const auto &node = nodes[stack.back()];
+            stack.pop_back();
+            if (!node.leaf) {
+                stack.emplace_back(node.children[Irrelevant]);
+                stack.emplace_back(node.children[facts.test(node.fact) ? True : False]);
+                continue;
+            }
+
+            for (auto id : node.conditions) {
+                if ((*conditions)[id].satisfiedBy(facts)) {
+                    return id;
+                }
+            }
+        }
+
+        return {};
+    }
+
+private:
+    static constexpr std::size_t LeafSize = 16;
+
+    enum Value : std::size_t {
+        False, True, Irrelevant
+    };
+
+    struct Node {
+        bool leaf = true;
+        FactId fact = 0;
+        std::array<std::size_t, 3> children{};
+        std::vector<NodeId> conditions;
+    };
+
+    static auto value(const Condition &condition, FactId fact) -> Value {
+        if (condition.getPositive().test(fact)) {
+            return True;
+        }
+
+        return condition.getNegative().test(fact) ? False : Irrelevant;
+    }
+
+    void split(std::size_t n) {
+        // the fact that the most conditions care about, ties are broken by the more balanced split
+        std::vector<std::array<std::size_t, 3>> counts(numFacts);
+        for (auto id : nodes[n].conditions) {
+            (*conditions)[id].getPositive().forEach([&counts](FactId f) { ++counts[f][True]; });
+            (*conditions)[id].getNegative().forEach([&counts](FactId f) { ++counts[f][False]; });
+        }
+
+        const auto size = nodes[n].conditions.size();
+        std::optional<FactId> best;
+        std::pair<std::size_t, std::size_t> bestScore;
+        for (FactId f = 0; f < numFacts; ++f) {
+            const auto &c = counts[f];
+            if (c[False] == size || c[True] == size || c[False] + c[True] == 0) {
+                continue;
+            }
+
+            const std::pair score(c[False] + c[True], std::min(c[False], c[True]));
+            if (!best.has_value() || score > bestScore) {
+                best = f;
+                bestScore = score;
+            }
+        }
+
+        if (!best.has_value()) {
+            return;
+        }
+
+        auto moved = std::move(nodes[n].conditions);
+        nodes[n].leaf = false;
+        nodes[n].fact = *best;
+        for (std::size_t c = False; c <= Irrelevant; ++c) {
+            nodes[n].children[c] = nodes.size() + c;
+        }
+
+        nodes.resize(nodes.size() + 3);
+
+        for (auto id : moved) {
+            nodes[nodes[n].children[value((*conditions)[id], *best)]].conditions.emplace_back(id);
+        }
+    }
+
+    std::size_t numFacts;
+    const std::vector<Condition> *conditions;
+    std::vector<Node> nodes;
+    mutable std::vector<std::size_t> stack;
+};
+
+struct Meeting {
+    NodeId forward;
+    NodeId backward;
+};
+
+int main(int argc, char **argv) {
+#ifdef DEBUG
+    assert(argc == 2);
+    auto input = InputBuffer::open(argv[1]);
+#else
+    auto input = InputBuffer::fromStdin();
+#endif
+    const auto task = Task::parse(std::move(input));
+    const auto &actions = task.getActions();
+    const auto numFacts = task.getFacts().size();
+    const SuccessorGenerator successors(actions, task.getStart());
+    std::vector<std::vector<std::size_t>> adders(numFacts);
+    std::vector<std::vector<std::size_t>> deleters(numFacts);
+    for (std::size_t a = 0; a < actions.size(); ++a) {
+        actions[a].getAddEffects().forEach([&](FactId f) { adders[f].emplace_back(a); });
+        actions[a].getDelEffects().forEach([&](FactId f) { deleters[f].emplace_back(a); });
+    }
+
+    NodeArena forwardNodes;
+    std::vector<State> forwardStates = {task.getStart()};
+    std::unordered_map<State, NodeId, State::Hash> forwardVisited = {{task.getStart(), forwardNodes.emplace()}};
+    std::vector<NodeId> forwardLayer = {0};
+
+    NodeArena backwardNodes;
+    std::vector<Condition> backwardConditions = {task.getTarget()};
+    std::unordered_map<Condition, NodeId, Condition::Hash> backwardVisited = {{task.getTarget(),
+                                                                               backwardNodes.emplace()}};
+    std::vector<NodeId> backwardLayer = {0};
+
+    MatchTree backwardFrontier(numFacts, backwardConditions);
+    backwardFrontier.insert(0);
+    std::optional<Meeting> best;
+    if (auto b = backwardFrontier.find(task.getStart().getFacts())) {
+        best = {0, *b};
+    }
+
+    std::vector<std::size_t> applicable;
+    std::vector<std::size_t> relevant;
+    while (!best.has_value() && !forwardLayer.empty() && !backwardLayer.empty()) {
+        if (forwardLayer.size() <= backwardLayer.size()) {
+            std::vector<NodeId> newLayer;
+            for (auto node : forwardLayer) {
+                successors.getApplicable(forwardStates[node], applicable);
+                for (auto a : applicable) {
+                    State successor = actions[a].applyTo(forwardStates[node]);
+                    if (forwardVisited.contains(successor)) {
+                        continue;
+                    }
+
+                    const auto id = forwardNodes.emplace(node, a);
+                    forwardVisited.emplace(successor, id);
+                    if (auto b = backwardFrontier.find(successor.getFacts()); b.has_value() && !best.has_value()) {
+                        best = {id, *b};
+                    }
+
+                    forwardStates.emplace_back(std::move(successor));
+                    newLayer.emplace_back(id);
+                }
+            }
+
+            forwardLayer = std::move(newLayer);
+        } else {
+            std::vector<NodeId> newLayer;
+            MatchTree newFrontier(numFacts, backwardConditions);
+            for (auto node : backwardLayer) {
+                relevant.clear();
+                backwardConditions[node].getPositive().forEach([&](FactId f) {
+                    relevant.insert(relevant.end(), adders[f].begin(), adders[f].end());
+                });
+                backwardConditions[node].getNegative().forEach([&](FactId f) {
+                    relevant.insert(relevant.end(), deleters[f].begin(), deleters[f].end());
+                });
+                std::sort(relevant.begin(), relevant.end());
+                relevant.erase(std::unique(relevant.begin(), relevant.end()), relevant.end());
+                for (auto a : relevant) {
+                    auto regressed = actions[a].regress(backwardConditions[node]);
+                    if (!regressed.has_value() || backwardVisited.contains(*regressed)) {
+                        continue;
+                    }
+
+                    const auto id = backwardNodes.emplace(node, a);
+                    backwardVisited.emplace(*regressed, id);
+                    backwardConditions.emplace_back(std::move(*regressed));
+                    newFrontier.insert(id);
+                    newLayer.emplace_back(id);
+                }
+            }
+
+            for (auto node : forwardLayer) {
+                if (auto b = newFrontier.find(forwardStates[node].getFacts())) {
+                    best = {node, *b};
+                    break;
+                }
+            }
+
+            backwardLayer = std::move(newLayer);
+            backwardFrontier = std::move(newFrontier);
+        }
+    }
+
+    if (!best.has_value()) {
+        std::cout << "Unloesbar" << std::endl;
+        return 0;
+    }
+
+    auto plan = forwardNodes.extractPlan(best->forward);
+    auto suffix = backwardNodes.extractPlan(best->backward);
+    plan.insert(plan.end(), suffix.rbegin(), suffix.rend());
+    task.printPlan(std::cout, plan);
+    std::cout << std::endl;
+    return 0;
+}
@@ -0,0 +1,310 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cassert>
+#include <cstdlib>
+#include <queue>
+#include <numeric>
+#include <algorithm>
+#include <filesystem>
+#include <unistd.h>
+#include "Task.hpp"
+#include "NodeArena.hpp"
+#include "SuccessorGenerator.hpp"
+#include "RunFile.hpp"
+
+/*
+ * External memory variant of GraphSearch with delayed duplicate detection. Every layer is a file of records
+ * (packed state, parent position, action) sorted by state, the parent position refers to the previous layer file.
+ * While a layer is expanded the successors are collected in a buffer of bounded size which is sorted and written as a
+ * run whenever it is full. Afterwards the runs are merged into the next layer, duplicates within the runs and states
+ * of any earlier layer are dropped on the fly since all of these files are sorted the same way. The states of all
+ * earlier layers are kept in one sorted visited file (states only) that is merged forward with every new layer, so a
+ * merge reads a single file for the duplicate detection regardless of the depth.
+ * Only the buffer and one block per open file have to fit into memory, the number of runs that are merged at once is
+ * bounded by the fan-in and larger layers are merged in several passes. The layer files are placed in
+ * $STRIPS_EXTERNAL_DIR (default: the temp directory), the buffer size in MiB is read from $STRIPS_EXTERNAL_MEMORY
+ * (default 256) and the fan-in from $STRIPS_EXTERNAL_FANIN (default 64, at least 2).
+ */
+
+using Word = RunWriter::Word;
+
+constexpr std::size_t DefaultMemoryMiB = 256;
+constexpr std::size_t DefaultFanIn = 64;
+
+class LayerStore {
+public:
+    explicit LayerStore(std::size_t numFacts) : stateWords((numFacts + BitSet::WordBits - 1) / BitSet::WordBits),
+                                       recordWords(stateWords + 2) {
+        const char *dir = std::getenv("STRIPS_EXTERNAL_DIR");
+        auto base = dir != nullptr && *dir != '\0' ? std::filesystem::path(dir) : std::filesystem::temp_directory_path();
+        directory = base / ("strips-bfs-" + std::to_string(::getpid()));
+        std::filesystem::create_directories(directory);
+        const char *memory = std::getenv("STRIPS_EXTERNAL_MEMORY");
+        const std::size_t mib = memory != nullptr && *memory != '\0' ? std::strtoull(memory, nullptr, 10)
+                                                                      : DefaultMemoryMiB;
+        bufferRecords = std::max<std::size_t>(1, (mib << 20u) / (recordWords * sizeof(Word)));
+        const char *width = std::getenv("STRIPS_EXTERNAL_FANIN");
+        fanIn = std::max<std::size_t>(2, width != nullptr && *width != '\0' ? std::strtoull(width, nullptr, 10)
+                                                                            : DefaultFanIn);
+    }
+
+    LayerStore(const LayerStore &) = delete;
+    auto operator=(const LayerStore &) -> LayerStore & = delete;
+
+    ~LayerStore() {
+        std::error_code ignored;
+        std::filesystem::remove_all(directory, ignored);
+    }
+
+    [[nodiscard]] auto layerPath(std::size_t depth) const -> std::string {
+        return (directory / ("layer" + std::to_string(depth))).string();
+    }
+
+    [[nodiscard]] auto visitedPath() const -> std::string {
+        return (directory / "visited").string();
+    }
+
+    [[nodiscard]] auto getRecordWords() const -> std::size_t {
+        return recordWords;
+    }
+
+    /**
+     * Orders records by state first, so equal states are adjacent and the smallest (parent, action) comes first
+     */
+    [[nodiscard]] bool less(const Word *a, const Word *b) const {
+        return std::lexicographical_compare(a, a + recordWords, b, b + recordWords);
+    }
+
+    [[nodiscard]] auto compareStates(const Word *a, const Word *b) const -> int {
+        for (std::size_t i = 0; i < stateWords; ++i) {
+            if (a[i] != b[i]) {
+                return a[i] < b[i] ? -1 : 1;
+            }
+        }
+
+        return 0;
+    }
+
+    void writeStart(const State &start) {
+        std::vector<Word> record(start.getFacts().getWords());
+        record.push_back(NodeArena::None);
+        record.push_back(NodeArena::None);
+        RunWriter writer(layerPath(0), recordWords);
+        writer.write(record.data());
+        writer.close();
+        RunWriter visited(visitedPath(), stateWords);
+        visited.write(record.data());
+        visited.close();
+    }
+
+    /**
+     * Buffers a successor, spilling the buffer to a new run if it is full
+     */
+    void add(const State &state, std::uint64_t parent, std::uint64_t action) {
+        const auto &words = state.getFacts().getWords();
+        buffer.insert(buffer.end(), words.begin(), words.end());
+        buffer.push_back(parent);
+        buffer.push_back(action);
+        if (buffer.size() >= bufferRecords * recordWords) {
+            spill();
+        }
+    }
+
+    /**
+     * Merges all runs into the file of layer depth, dropping duplicates and states of the layers 0 .. depth - 1. The new
+     * states are merged into the visited file at the same time. At most fanIn runs are open at once, if there are more
+     * runs they are merged in groups of fanIn into longer runs first
+     * @param depth
+     * @return number of states in the new layer
+     */
+    auto mergeLayer(std::size_t depth) -> std::uint64_t {
+        spill();
+        while (runs.size() > fanIn) {
+            std::vector<std::string> merged;
+            for (std::size_t first = 0; first < runs.size(); first += fanIn) {
+                const auto last = std::min(runs.size(), first + fanIn);
+                if (last - first == 1) {
+                    merged.emplace_back(runs[first]);
+                    continue;
+                }
+
+                merged.emplace_back(runPath(nextRun++));
+                RunWriter out(merged.back(), recordWords);
+                mergeRuns(first, last, [&out](const Word *record) { out.write(record); });
+                out.close();
+            }
+
+            runs = std::move(merged);
+        }
+
+        RunReader visited(visitedPath(), stateWords);
+        bool visitedValid = visited.next();
+        const auto nextVisitedPath = visitedPath() + ".next";
+        RunWriter nextVisited(nextVisitedPath, stateWords);
+        RunWriter out(layerPath(depth), recordWords);
+        mergeRuns(0, runs.size(), [&](const Word *record) {
+            // the visited states before record are copied, a visited state equal to record is copied later
+            int cmp = 1;
+            while (visitedValid && (cmp = compareStates(visited.current(), record)) < 0) {
+                nextVisited.write(visited.current());
+                visitedValid = visited.next();
+            }
+
+            if (!visitedValid || cmp != 0) {
+                out.write(record);
+                nextVisited.write(record);
+            }
+        });
+
+        for (; visitedValid; visitedValid = visited.next()) {
+            nextVisited.write(visited.current());
+        }
+
+        out.close();
+        nextVisited.close();
+        std::filesystem::rename(nextVisitedPath, visitedPath());
+        runs.clear();
+        nextRun = 0;
+        return out.size();
+    }
+
+    /**
+     * Follows the parent positions back through the layer files
+     * @param record of the target state
+     * @param depth layer of record
+     * @return action indices from the start state
+     */
+    [[nodiscard]] auto extractPlan(const Word *record, std::size_t depth) const -> std::vector<std::size_t> {
+        std::vector<std::size_t> plan;
+        std::vector<Word> current(record, record + recordWords);
+        for (; depth > 0; --depth) {
+            plan.emplace_back(current[stateWords + 1]);
+            RunReader(layerPath(depth - 1), recordWords).readAt(current[stateWords], current.data());
+        }
+
+        std::reverse(plan.begin(), plan.end());
+        return plan;
+    }
+
+private:
+    [[nodiscard]] auto runPath(std::size_t run) const -> std::string {
+        return (directory / ("run" + std::to_string(run))).string();
+    }
+
+    void spill() {
+        const auto n = buffer.size() / recordWords;
+        if (n == 0) {
+            return;
+        }
+
+        std::vector<std::size_t> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return less(buffer.data() + a * recordWords, buffer.data() + b * recordWords);
+        });
+
+        runs.emplace_back(runPath(nextRun++));
+        RunWriter writer(runs.back(), recordWords);
+        const Word *last = nullptr;
+        for (auto i : order) {
+            const Word *record = buffer.data() + i * recordWords;
+            if (last == nullptr || compareStates(last, record) != 0) {
+                writer.write(record);
+                last = record;
+            }
+        }
+
+        writer.close();
+        buffer.clear();
+    }
+
+    /**
+     * Merges the runs first .. last - 1 and deletes them afterwards
+     * @param fun called with the smallest record of every state in ascending order
+     */
+    template<typename FUN>
+    void mergeRuns(std::size_t first, std::size_t last, FUN &&fun) {
+        std::vector<RunReader> inputs;
+        for (auto r = first; r < last; ++r) {
+            inputs.emplace_back(runs[r], recordWords);
+        }
+
+        auto greater = [&](std::size_t a, std::size_t b) { return less(inputs[b].current(), inputs[a].current()); };
+        std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(greater)> heap(greater);
+        for (std::size_t r = 0; r < inputs.size(); ++r) {
+            if (inputs[r].next()) {
+                heap.push(r);
+            }
+        }
+
+        std::vector<Word> lastRecord;
+        while (!heap.empty()) {
+            const auto r = heap.top();
+            heap.pop();
+            const Word *record = inputs[r].current();
+            if (lastRecord.empty() || compareStates(lastRecord.data(), record) != 0) {
+                lastRecord.assign(record, record + recordWords);
+                fun(record);
+            }
+
+            if (inputs[r].next()) {
+                heap.push(r);
+            }
+        }
+
+        inputs.clear();
+        for (auto r = first; r < last; ++r) {
+            std::filesystem::remove(runs[r]);
+        }
+    }
+
+    std::size_t stateWords;
+    std::size_t recordWords;
+    std::filesystem::path directory;
+    std::size_t bufferRecords;
+    std::size_t fanIn;
+    std::vector<Word> buffer;
+    std::vector<std::string> runs;
+    std::size_t nextRun = 0;
+};
+
+int main(int argc, char **argv) {
+#ifdef DEBUG
+    assert(argc == 2);
+    auto input = InputBuffer::open(argv[1]);
+#else
+    auto input = InputBuffer::fromStdin();
+#endif
+    const auto task = Task::parse(std::move(input));
+    const auto &actions = task.getActions();
+    const auto numFacts = task.getFacts().size();
+    const SuccessorGenerator successors(actions, task.getStart());
+    LayerStore store(numFacts);
+    store.writeStart(task.getStart());
+    std::vector<std::size_t> applicable;
+    for (std::size_t depth = 0;; ++depth) {
+        RunReader layer(store.layerPath(depth), store.getRecordWords());
+        std::uint64_t pos = 0;
+        for (; layer.next(); ++pos) {
+            const State current(BitSet(numFacts, layer.current()));
+            if (current.isSolutionOf(task.getTarget())) {
+                task.printPlan(std::cout, store.extractPlan(layer.current(), depth));
+                std::cout << std::endl;
+                return 0;
+            }
+
+            successors.getApplicable(current, applicable);
+            for (auto a : applicable) {
+                store.add(actions[a].applyTo(current), pos, a);
+            }
+        }
+
+        if (store.mergeLayer(depth + 1) == 0) {
+            break;
+        }
+    }
+
+    std::cout << "Unloesbar" << std::endl;
+    return 0;
+}
@@ -0,0 +1,205 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include "Task.hpp"
+#include "SuccessorGenerator.hpp"
+
+/*
+ * Iterative deepening depth first search. A single state is modified in place, the facts changed by an action are
+ * pushed onto a trail and flipped back on backtracking, so the memory needed is proportional to the depth of the
+ * plan. States that already occur on the current path are skipped (the zobrist hashes are compared first, the facts
+ * only on equal hashes), hence every iteration is finite and the search reports Unloesbar once an iteration is not cut
+ * off by the depth limit anymore. The first plan found is a shortest one.
+ * Compiled with TRANSPOSITION_TABLE, a table of fixed size additionally prunes states that were already searched in
+ * the same iteration with at least the same remaining depth. A stored result may depend on the path it was searched
+ * from (a successor matched a state above the subtree), but this does not lose plans: in the iteration with the
+ * length L of a shortest plan, a state reached at depth d is pruned by the path only if it was reached at a smaller
+ * depth before, so every plan through it is longer than L. A state s of a shortest plan is entered at depth dist(s)
+ * unless an entry with at least the remaining depth covers it, which means s was entered at depth dist(s) before and
+ * its search already found the plan. Likewise an iteration below L is always cut off, since the last state of a
+ * shortest plan prefix that is entered has a successor on the plan that is entered as well unless the depth limit is
+ * reached.
+ */
+
+#ifdef TRANSPOSITION_TABLE
+/**
+ * Direct mapped table, a colliding entry is simply replaced. The entries keep the facts of their state, so a hash
+ * collision never prunes a different state. The number of entries is bounded such that the facts of all entries take
+ * about TableBytes
+ */
+class TranspositionTable {
+public:
+    static constexpr std::size_t MaxSize = 1 << 20;
+    static constexpr std::size_t TableBytes = std::size_t(64) << 20u;
+
+    explicit TranspositionTable(std::size_t numFacts) : entries(std::clamp<std::size_t>(
+            TableBytes / ((numFacts + BitSet::WordBits - 1) / BitSet::WordBits * sizeof(BitSet::Word) + 1), 1,
+            MaxSize)) {}
+
+    /**
+     * @param state
+     * @param remaining
+     * @param iteration
+     * @param cutoff set if the stored search was cut off by the depth limit
+     * @return true if the state was already searched with at least remaining depth in this iteration
+     */
+    bool covers(const State &state, std::size_t remaining, std::size_t iteration, bool &cutoff) const {
+        const auto &e = entries[state.getHash() % entries.size()];
+        if (e.hash == state.getHash() && e.iteration == iteration && e.remaining >= remaining &&
+            e.facts == state.getFacts()) {
+            cutoff = cutoff || e.cutoff;
+            return true;
+        }
+
+        return false;
+    }
+
+    void store(const State &state, std::size_t remaining, std::size_t iteration, bool cutoff) {
+        auto &e = entries[state.getHash() % entries.size()];
+        e.hash = state.getHash();
+        e.facts = state.getFacts();
+        e.iteration = iteration;
+        e.remaining = remaining;
+        e.cutoff = cutoff;
+    }
+
+private:
+    struct Entry {
+        std::uint64_t hash = 0;
+        BitSet facts;
+        std::size_t iteration = 0;
+        std::size_t remaining = 0;
+        bool cutoff = false;
+    };
+
+    std::vector<Entry> entries;
+};
+#endif
+
+struct Frame {
+    std::vector<std::size_t> applicable;
+    std::size_t next;
+    // trail size before the action leading to this node was applied
+    std::size_t trailMark;
+    bool cutoff;
+};
+
+int main(int argc, char **argv) {
+#ifdef DEBUG
+    assert(argc == 2);
+    auto input = InputBuffer::open(argv[1]);
+#else
+    auto input = InputBuffer::fromStdin();
+#endif
+    const auto task = Task::parse(std::move(input));
+    const auto &actions = task.getActions();
+    const SuccessorGenerator successors(actions, task.getStart());
+    State current = task.getStart();
+    std::vector<FactId> trail;
+    // path[d] is the state at depth d of the current path, the entries beyond depth are stale
+    std::vector<State> path;
+    std::vector<std::size_t> plan;
+    std::vector<Frame> frames;
+#ifdef TRANSPOSITION_TABLE
+    TranspositionTable table(task.getFacts().size());
+#endif
+    for (std::size_t limit = 0;; ++limit) {
+        bool cutoff = false;
+        std::size_t depth = 0;
+        path.assign(1, current);
+        auto enter = [&](std::size_t trailMark) -> bool {
+            if (current.isSolutionOf(task.getTarget())) {
+                return true;
+            }
+
+            if (frames.size() <= depth) {
+                frames.emplace_back();
+            }
+
+            auto &frame = frames[depth];
+            frame.next = 0;
+            frame.trailMark = trailMark;
+            frame.cutoff = false;
+            if (depth == limit) {
+                frame.applicable.clear();
+                frame.cutoff = true;
+            } else {
+                successors.getApplicable(current, frame.applicable);
+            }
+
+            return false;
+        };
+
+        if (enter(0)) {
+            break;
+        }
+
+        while (true) {
+            auto &frame = frames[depth];
+            if (frame.next == frame.applicable.size()) {
+                // subtree exhausted: backtrack
+#ifdef TRANSPOSITION_TABLE
+                table.store(current, limit - depth, limit, frame.cutoff);
+#endif
+                if (depth == 0) {
+                    cutoff = frame.cutoff;
+                    break;
+                }
+
+                const bool childCutoff = frame.cutoff;
+                --depth;
+                auto &parent = frames[depth];
+                parent.cutoff = parent.cutoff || childCutoff;
+                while (trail.size() > frame.trailMark) {
+                    current.flip(trail.back());
+                    trail.pop_back();
+                }
+
+                plan.pop_back();
+                continue;
+            }
+
+            const auto a = frame.applicable[frame.next++];
+            const auto mark = trail.size();
+            actions[a].applyInPlace(current, trail);
+            bool skip = std::find(path.begin(), path.begin() + depth + 1, current) != path.begin() + depth + 1;
+#ifdef TRANSPOSITION_TABLE
+            skip = skip || table.covers(current, limit - depth - 1, limit, frame.cutoff);
+#endif
+            if (skip) {
+                while (trail.size() > mark) {
+                    current.flip(trail.back());
+                    trail.pop_back();
+                }
+
+                continue;
+            }
+
+            plan.emplace_back(a);
+            ++depth;
+            if (path.size() == depth) {
+                path.emplace_back(current);
+            } else {
+                path[depth] = current;
+            }
+
+            if (enter(mark)) {
+                task.printPlan(std::cout, plan);
+                std::cout << std::endl;
+                return 0;
+            }
+        }
+
+        if (!cutoff) {
+            std::cout << "Unloesbar" << std::endl;
+            return 0;
+        }
+    }
+
+    // the start state is a solution
+    task.printPlan(std::cout, plan);
+    std::cout << std::endl;
+    return 0;
+}
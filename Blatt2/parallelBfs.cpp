@@ -0,0 +1,103 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <unordered_set>
+#include "Task.hpp"
+#include "NodeArena.hpp"
+#include "SuccessorGenerator.hpp"
+#include "ShardedStateMap.hpp"
+
+/*
+ * Layer synchronous variant of GraphSearch. All states of one depth are expanded by a pool of workers. The closed
+ * list only holds states of earlier layers and is read only while a layer is expanded. Duplicates within the new
+ * layer are merged in a sharded map that keeps the smallest (parent position, action) pair per state. Sorting the
+ * new layer by that pair reproduces the order in which GraphSearch would have generated it, so both return the same
+ * plan.
+ */
+
+constexpr std::size_t ChunkSize = 64;
+constexpr std::size_t BatchSize = 1024;
+
+int main(int argc, char **argv) {
+#ifdef DEBUG
+    assert(argc == 2);
+    auto input = InputBuffer::open(argv[1]);
+#else
+    auto input = InputBuffer::fromStdin();
+#endif
+    const auto task = Task::parse(std::move(input));
+    const auto &actions = task.getActions();
+    const SuccessorGenerator successors(actions, task.getStart());
+    const auto numThreads = std::max(1u, std::thread::hardware_concurrency());
+    NodeArena nodes;
+    std::vector<std::pair<State, NodeId>> layer = {{task.getStart(), nodes.emplace()}};
+    std::unordered_set<State, State::Hash> visited = {task.getStart()};
+    ShardedStateMap nextLayer(numThreads * 8);
+    while (!layer.empty()) {
+        for (const auto &[state, node] : layer) {
+            if (state.isGoal()) {
+                task.printPlan(std::cout, nodes.extractPlan(node));
+                std::cout << std::endl;
+                return 0;
+            }
+        }
+
+        std::atomic_size_t nextChunk = 0;
+        auto worker = [&]() {
+            std::vector<std::size_t> applicable;
+            std::vector<ShardedStateMap::Entry> buffer;
+            buffer.reserve(BatchSize);
+            std::size_t begin;
+            while ((begin = nextChunk.fetch_add(ChunkSize)) < layer.size()) {
+                const auto end = std::min(begin + ChunkSize, layer.size());
+                for (auto pos = begin; pos < end; ++pos) {
+                    const auto &current = layer[pos].first;
+                    successors.getApplicable(current, applicable);
+                    for (auto a : applicable) {
+                        State successor = actions[a].applyTo(current);
+                        if (!visited.contains(successor)) {
+                            buffer.emplace_back(std::move(successor), ShardedStateMap::Key(pos, a));
+                        }
+                    }
+
+                    if (buffer.size() >= BatchSize) {
+                        nextLayer.insert(buffer);
+                    }
+                }
+            }
+
+            nextLayer.insert(buffer);
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned int i = 1; i < numThreads; ++i) {
+            workers.emplace_back(worker);
+        }
+
+        worker();
+        for (auto &t : workers) {
+            t.join();
+        }
+
+        auto generated = nextLayer.extract();
+        std::sort(generated.begin(), generated.end(), [](const auto &a, const auto &b) {
+            return a.second < b.second;
+        });
+
+        std::vector<std::pair<State, NodeId>> newLayer;
+        newLayer.reserve(generated.size());
+        for (auto &[state, key] : generated) {
+            const auto [pos, action] = key;
+            visited.emplace(state);
+            newLayer.emplace_back(std::move(state), nodes.emplace(layer[pos].second, action));
+        }
+
+        layer = std::move(newLayer);
+    }
+
+    std::cout << "Unloesbar" << std::endl;
+    return 0;
+}
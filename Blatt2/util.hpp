@@ -0,0 +1,41 @@
+#ifndef BLATT2_UTIL_HPP
+#define BLATT2_UTIL_HPP
+#include <string_view>
+
+namespace util {
+    /**
+     * Splits a string_view at a delimiter without copying. Behaves like repeated std::getline: an empty text yields
+     * no token and a delimiter at the very end does not start another token
+     */
+    class Tokenizer {
+    public:
+        Tokenizer(std::string_view text, char delimiter) : rest(text), delimiter(delimiter) {}
+
+        bool next(std::string_view &token) {
+            if (rest.empty()) {
+                return false;
+            }
+
+            auto pos = rest.find(delimiter);
+            if (pos == std::string_view::npos) {
+                token = rest;
+                rest = {};
+            } else {
+                token = rest.substr(0, pos);
+                rest.remove_prefix(pos + 1);
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] auto remaining() const -> std::string_view {
+            return rest;
+        }
+
+    private:
+        std::string_view rest;
+        char delimiter;
+    };
+}
+
+#endif //BLATT2_UTIL_HPP
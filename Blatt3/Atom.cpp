@@ -0,0 +1,39 @@
+#include "Atom.hpp"
+#include <deque>
+#include <unordered_map>
+#include <cassert>
+
+namespace {
+    struct Atoms {
+        std::deque<VariablePredicate> atoms;
+        std::unordered_multimap<std::uint64_t, AtomId> ids;
+    };
+
+    auto atoms() -> Atoms & {
+        static Atoms table;
+        return table;
+    }
+}
+
+auto AtomTable::intern(const VariablePredicate &atom, std::uint64_t hash) -> AtomId {
+    assert(atom.isAtomic());
+    auto &table = atoms();
+    auto [begin, end] = table.ids.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+        const auto &candidate = table.atoms[it->second];
+        if (candidate.getSymbol() == atom.getSymbol() && candidate.getVariables() == atom.getVariables()) {
+            return it->second;
+        }
+    }
+
+    const auto id = static_cast<AtomId>(table.atoms.size());
+    table.atoms.emplace_back(atom.getSymbol(), atom.getVariables());
+    table.ids.emplace(hash, id);
+    return id;
+}
+
+auto AtomTable::get(AtomId id) -> const VariablePredicate & {
+    const auto &table = atoms();
+    assert(id < table.atoms.size());
+    return table.atoms[id];
+}
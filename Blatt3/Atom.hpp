@@ -0,0 +1,40 @@
+#ifndef BLATT3_ATOM_HPP
+#define BLATT3_ATOM_HPP
+#include <cstdint>
+#include "VariablePredicate.hpp"
+
+using AtomId = std::uint32_t;
+
+/**
+ * Interns ground atoms (predicate name and constant arguments, without truth value). Every distinct atom gets a
+ * dense AtomId, so sets of atoms can be stored as sorted integer lists. Atoms are never removed
+ */
+class AtomTable {
+public:
+    /**
+     * @param atom must be atomic, the truth value is ignored
+     * @param hash atom.atomHash()
+     * @return the id of atom, a new one if atom was not interned before
+     */
+    static auto intern(const VariablePredicate &atom, std::uint64_t hash) -> AtomId;
+
+    /**
+     * @param id must have been returned by intern
+     * @return the atom as positive predicate
+     */
+    static auto get(AtomId id) -> const VariablePredicate &;
+
+    /**
+     * Pseudo random 64 bit key of an atom (splitmix64 of the id). The hash of a set of atoms is the xor of the keys
+     * @param id
+     * @return
+     */
+    static auto key(AtomId id) -> std::uint64_t {
+        std::uint64_t z = static_cast<std::uint64_t>(id) + 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27u)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31u);
+    }
+};
+
+#endif //BLATT3_ATOM_HPP
@@ -0,0 +1,308 @@
+#include "Grounder.hpp"
+#include "Operator.hpp"
+#include "Type.hpp"
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <cstdint>
+#include <cassert>
+
+namespace {
+    void combine(std::uint64_t &hash, Term t) {
+        hash ^= Term::Hash()(t) + 0x9e3779b97f4a7c15ull + (hash << 6u) + (hash >> 2u);
+    }
+}
+
+Grounder::Grounder(const Operator &op, bool injective) : name(op.getName()), injective(injective) {
+    for (const auto &pre : op.getPreconditions()) {
+        addLiteral(pre, preconditions, true);
+    }
+
+    for (const auto &eff : op.getEffects()) {
+        addLiteral(eff, effects, false);
+    }
+
+    types.assign(variables.size(), NoType);
+    for (const auto &[variable, type] : op.getTypes()) {
+        auto it = std::find(variables.begin(), variables.end(), variable);
+        if (it != variables.end()) {
+            types[static_cast<std::size_t>(it - variables.begin())] = type;
+        }
+    }
+}
+
+void Grounder::addLiteral(const VariablePredicate &pred, std::vector<Literal> &literals, bool newSlots) {
+    Literal literal{pred.getSymbol(), pred.getTruthVal(), pred.getVariables(), {}};
+    for (const auto &arg : literal.args) {
+        auto it = std::find(variables.begin(), variables.end(), arg);
+        if (!arg.isVariable() || (it == variables.end() && !newSlots)) {
+            literal.slots.emplace_back(NoSlot);
+            continue;
+        }
+
+        literal.slots.emplace_back(static_cast<std::size_t>(it - variables.begin()));
+        if (it == variables.end()) {
+            variables.emplace_back(arg);
+        }
+    }
+
+    literals.emplace_back(std::move(literal));
+}
+
+auto Grounder::getVariables() const -> const std::vector<Term> & {
+    return variables;
+}
+
+auto Grounder::getPreconditions() const -> const std::vector<Literal> & {
+    return preconditions;
+}
+
+auto Grounder::getName() const -> const std::string & {
+    return name;
+}
+
+bool Grounder::matches(const Literal &literal, const VariablePredicate &fact) const {
+    const auto &values = fact.getVariables();
+    if (fact.getSymbol() != literal.predicate || fact.getTruthVal() != literal.truthVal ||
+        values.size() != literal.args.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (literal.slots[i] == NoSlot) {
+            if (values[i] != literal.args[i]) {
+                return false;
+            }
+
+            continue;
+        }
+
+        if (types[literal.slots[i]] != NoType && !TypeTable::isA(values[i], types[literal.slots[i]])) {
+            return false;
+        }
+
+        // a variable that occurs twice in the literal needs the same value at both positions
+        for (std::size_t j = 0; j < i; ++j) {
+            if (literal.slots[j] == literal.slots[i] && values[j] != values[i]) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool Grounder::extend(const Literal &literal, const VariablePredicate &fact, const std::vector<bool> &bound,
+                      const Term *row, Term *result) const {
+    const auto width = variables.size();
+    std::copy(row, row + width, result);
+    const auto &args = fact.getVariables();
+    for (std::size_t k = 0; k < args.size(); ++k) {
+        const auto slot = literal.slots[k];
+        if (slot == NoSlot) {
+            continue;
+        }
+
+        if (bound[slot]) {
+            if (row[slot] != args[k]) {
+                return false;
+            }
+
+            continue;
+        }
+
+        if (injective) {
+            for (std::size_t s = 0; s < width; ++s) {
+                if (bound[s] && row[s] == args[k]) {
+                    return false;
+                }
+            }
+
+            for (std::size_t j = 0; j < k; ++j) {
+                const auto other = literal.slots[j];
+                if (other != NoSlot && other != slot && !bound[other] && args[j] == args[k]) {
+                    return false;
+                }
+            }
+        }
+
+        result[slot] = args[k];
+    }
+
+    return true;
+}
+
+auto Grounder::joinOrder(const std::vector<std::vector<std::size_t>> &relations) const -> std::vector<std::size_t> {
+    std::vector<std::size_t> order;
+    std::vector<bool> joined(preconditions.size(), false);
+    std::vector<bool> bound(variables.size(), false);
+    while (order.size() < preconditions.size()) {
+        std::size_t best = NoSlot;
+        bool bestConnected = false;
+        for (std::size_t i = 0; i < preconditions.size(); ++i) {
+            if (joined[i]) {
+                continue;
+            }
+
+            const auto &slots = preconditions[i].slots;
+            const bool connected = std::any_of(slots.begin(), slots.end(), [&bound](std::size_t slot) {
+                return slot != NoSlot && bound[slot];
+            });
+
+            // relations that share a variable with the joined ones first, then the smallest relation
+            if (best == NoSlot || (connected && !bestConnected) ||
+                (connected == bestConnected && relations[i].size() < relations[best].size())) {
+                best = i;
+                bestConnected = connected;
+            }
+        }
+
+        joined[best] = true;
+        for (auto slot : preconditions[best].slots) {
+            if (slot != NoSlot) {
+                bound[slot] = true;
+            }
+        }
+
+        order.emplace_back(best);
+    }
+
+    return order;
+}
+
+auto Grounder::ground(const State &state) const -> Bindings {
+    const auto &facts = state.getPredicates();
+    const auto numPreconditions = preconditions.size();
+    const auto width = variables.size();
+    assert(state.isAtomic());
+    std::vector<std::vector<std::size_t>> relations(numPreconditions);
+    for (std::size_t i = 0; i < numPreconditions; ++i) {
+        for (auto f : state.getBucket(preconditions[i].predicate)) {
+            if (matches(preconditions[i], facts[f])) {
+                relations[i].emplace_back(f);
+            }
+        }
+    }
+
+    if (std::any_of(relations.begin(), relations.end(), [](const auto &r) { return r.empty(); })) {
+        return {width, 0, {}};
+    }
+
+    // the partial bindings are stored row by row, values by slot and the matched fact by precondition
+    std::vector<Term> values(width);
+    std::vector<std::size_t> matched(numPreconditions);
+    std::size_t numRows = 1;
+    std::vector<bool> bound(width, false);
+    for (auto p : joinOrder(relations)) {
+        const auto &literal = preconditions[p];
+        std::vector<std::size_t> keyArgs;
+        std::vector<std::size_t> newArgs;
+        for (std::size_t k = 0; k < literal.slots.size(); ++k) {
+            const auto slot = literal.slots[k];
+            if (slot == NoSlot) {
+                continue;
+            }
+
+            if (bound[slot]) {
+                keyArgs.emplace_back(k);
+            } else if (std::find(literal.slots.begin(), literal.slots.begin() + static_cast<long>(k), slot) ==
+                       literal.slots.begin() + static_cast<long>(k)) {
+                newArgs.emplace_back(k);
+            }
+        }
+
+        std::unordered_map<std::uint64_t, std::vector<std::size_t>> table;
+        for (auto f : relations[p]) {
+            std::uint64_t hash = 0;
+            for (auto k : keyArgs) {
+                combine(hash, facts[f].getVariables()[k]);
+            }
+
+            table[hash].emplace_back(f);
+        }
+
+        std::vector<Term> newValues;
+        std::vector<std::size_t> newMatched;
+        std::size_t newRows = 0;
+        for (std::size_t r = 0; r < numRows; ++r) {
+            const Term *row = values.data() + r * width;
+            std::uint64_t hash = 0;
+            for (auto k : keyArgs) {
+                combine(hash, row[literal.slots[k]]);
+            }
+
+            auto candidates = table.find(hash);
+            if (candidates == table.end()) {
+                continue;
+            }
+
+            for (auto f : candidates->second) {
+                newValues.resize((newRows + 1) * width);
+                if (!extend(literal, facts[f], bound, row, newValues.data() + newRows * width)) {
+                    newValues.resize(newRows * width);
+                    continue;
+                }
+
+                newMatched.insert(newMatched.end(), matched.begin() + static_cast<long>(r * numPreconditions),
+                                  matched.begin() + static_cast<long>((r + 1) * numPreconditions));
+                newMatched[newRows * numPreconditions + p] = f;
+                ++newRows;
+            }
+        }
+
+        for (auto k : newArgs) {
+            bound[literal.slots[k]] = true;
+        }
+
+        values = std::move(newValues);
+        matched = std::move(newMatched);
+        numRows = newRows;
+        if (numRows == 0) {
+            return {width, 0, {}};
+        }
+    }
+
+    // same order as enumerating the candidates of the preconditions one after another
+    std::vector<std::size_t> rows(numRows);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::sort(rows.begin(), rows.end(), [&matched, numPreconditions](std::size_t a, std::size_t b) {
+        return std::lexicographical_compare(matched.begin() + static_cast<long>(a * numPreconditions),
+                                            matched.begin() + static_cast<long>((a + 1) * numPreconditions),
+                                            matched.begin() + static_cast<long>(b * numPreconditions),
+                                            matched.begin() + static_cast<long>((b + 1) * numPreconditions));
+    });
+
+    Bindings ret{width, numRows, {}};
+    ret.values.reserve(numRows * width);
+    for (auto r : rows) {
+        const auto begin = values.begin() + static_cast<long>(r * width);
+        ret.values.insert(ret.values.end(), begin, begin + static_cast<long>(width));
+    }
+
+    return ret;
+}
+
+auto Grounder::instantiate(const Literal &literal, const Term *binding) -> VariablePredicate {
+    std::vector<Term> args(literal.args.size());
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        args[i] = literal.slots[i] == NoSlot ? literal.args[i] : binding[literal.slots[i]];
+    }
+
+    return {literal.predicate, std::move(args), literal.truthVal};
+}
+
+auto Grounder::instantiate(const Term *binding) const -> Operator {
+    Operator::PredList pre;
+    pre.reserve(preconditions.size());
+    for (const auto &literal : preconditions) {
+        pre.emplace_back(instantiate(literal, binding));
+    }
+
+    Operator::PredList eff;
+    eff.reserve(effects.size());
+    for (const auto &literal : effects) {
+        eff.emplace_back(instantiate(literal, binding));
+    }
+
+    return {name, std::move(pre), std::move(eff)};
+}
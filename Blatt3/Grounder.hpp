@@ -0,0 +1,114 @@
+#ifndef BLATT3_GROUNDER_HPP
+#define BLATT3_GROUNDER_HPP
+#include <vector>
+#include <cstddef>
+#include <string>
+#include "Symbol.hpp"
+#include "State.hpp"
+
+class Operator;
+
+/**
+ * Join based grounding of one operator. Every precondition is a relation over the facts of a state (the facts with
+ * the same predicate, truth value and matching constants). The relations are joined one after another with hash
+ * joins on the variables they share with the relations joined before, starting with the smallest relation. Facts
+ * whose values do not have the types of the typed variables are filtered out of the relations before the join
+ */
+class Grounder {
+public:
+    static constexpr std::size_t NoSlot = static_cast<std::size_t>(-1);
+    static constexpr Symbol NoType = static_cast<Symbol>(-1);
+
+    /**
+     * Literal of the operator with the slot of every argument, NoSlot for constants and variables without slot
+     */
+    struct Literal {
+        Symbol predicate;
+        bool truthVal;
+        std::vector<Term> args;
+        std::vector<std::size_t> slots;
+    };
+
+    /**
+     * Values of the precondition variables, one fixed size row per binding, indexed by slot (see getVariables)
+     */
+    struct Bindings {
+        std::size_t width = 0;
+        std::size_t size = 0;
+        std::vector<Term> values;
+
+        auto operator[](std::size_t i) const -> const Term * {
+            return values.data() + i * width;
+        }
+    };
+
+    /**
+     * @param op
+     * @param injective if true, different variables are never bound to the same constant
+     */
+    Grounder(const Operator &op, bool injective);
+
+    /**
+     * All bindings of the precondition variables under which every precondition is a fact of state. The bindings are
+     * ordered lexicographically by the positions of the matched facts in the state, precondition by precondition
+     * @param state must be atomic
+     * @return
+     */
+    [[nodiscard]] auto ground(const State &state) const -> Bindings;
+
+    /**
+     * Substitutes the variables of the operator by the values of a binding. Variables that only occur in the effects
+     * are kept
+     * @param binding row of Bindings
+     * @return
+     */
+    [[nodiscard]] auto instantiate(const Term *binding) const -> Operator;
+
+    /**
+     * The variable of every slot in order of first occurrence in the preconditions
+     * @return
+     */
+    [[nodiscard]] auto getVariables() const -> const std::vector<Term> &;
+
+    [[nodiscard]] auto getPreconditions() const -> const std::vector<Literal> &;
+
+    [[nodiscard]] auto getName() const -> const std::string &;
+
+    /**
+     * True if fact has the predicate, truth value and constants of literal, equal values at the positions of a
+     * variable that occurs more than once and values of the types of the typed variables
+     * @param literal
+     * @param fact must be atomic
+     * @return
+     */
+    [[nodiscard]] bool matches(const Literal &literal, const VariablePredicate &fact) const;
+
+    /**
+     * Extends a binding by a fact that matches literal. The values of the slots bound before must agree with the
+     * fact, if the grounder is injective the values of the new slots must differ from all other values
+     * @param literal
+     * @param fact
+     * @param bound the slots bound by row
+     * @param row binding to extend
+     * @param result extended binding, getVariables().size() values
+     * @return false if fact is not consistent with row
+     */
+    [[nodiscard]] bool extend(const Literal &literal, const VariablePredicate &fact, const std::vector<bool> &bound,
+                              const Term *row, Term *result) const;
+
+private:
+    void addLiteral(const VariablePredicate &pred, std::vector<Literal> &literals, bool newSlots);
+    [[nodiscard]] static auto instantiate(const Literal &literal, const Term *binding) -> VariablePredicate;
+    [[nodiscard]] auto joinOrder(const std::vector<std::vector<std::size_t>> &relations) const
+        -> std::vector<std::size_t>;
+
+    std::string name;
+    std::vector<Literal> preconditions;
+    std::vector<Literal> effects;
+    std::vector<Term> variables;
+    // type of every slot, NoType for untyped variables
+    std::vector<Symbol> types;
+    bool injective;
+};
+
+#endif //BLATT3_GROUNDER_HPP
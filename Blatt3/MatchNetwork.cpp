@@ -0,0 +1,320 @@
+#include "MatchNetwork.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+
+MatchNetwork::MatchNetwork(const Operator &op, bool injective) : grounder(op, injective) {
+    const auto &preconditions = grounder.getPreconditions();
+    if (std::any_of(preconditions.begin(), preconditions.end(), [](const auto &p) { return !p.truthVal; })) {
+        throw std::invalid_argument("MatchNetwork: negative precondition in operator " + op.getName());
+    }
+
+    // preconditions that share a variable with the levels before come first, otherwise the order of the operator
+    std::vector<bool> bound(grounder.getVariables().size(), false);
+    std::vector<bool> joined(preconditions.size(), false);
+    while (order.size() < preconditions.size()) {
+        std::size_t next = Grounder::NoSlot;
+        for (std::size_t i = 0; i < preconditions.size() && next == Grounder::NoSlot; ++i) {
+            const auto &slots = preconditions[i].slots;
+            if (!joined[i] && std::any_of(slots.begin(), slots.end(), [&bound](std::size_t slot) {
+                return slot != Grounder::NoSlot && bound[slot];
+            })) {
+                next = i;
+            }
+        }
+
+        if (next == Grounder::NoSlot) {
+            next = static_cast<std::size_t>(std::find(joined.begin(), joined.end(), false) - joined.begin());
+        }
+
+        boundBefore.emplace_back(bound);
+        for (auto slot : preconditions[next].slots) {
+            if (slot != Grounder::NoSlot) {
+                bound[slot] = true;
+            }
+        }
+
+        joined[next] = true;
+        order.emplace_back(next);
+    }
+}
+
+void MatchNetwork::join(Memory &memory, std::size_t level, const std::vector<Term> &values,
+                        const std::vector<AtomId> &atoms, std::size_t count, const std::vector<AtomId> &candidates,
+                        std::vector<Term> &newValues, std::vector<AtomId> &newAtoms) const {
+    const auto width = grounder.getVariables().size();
+    const auto &literal = grounder.getPreconditions()[order[level]];
+    newValues.clear();
+    newAtoms.clear();
+    std::size_t size = 0;
+    for (auto candidate : candidates) {
+        const auto &fact = AtomTable::get(candidate);
+        for (std::size_t i = 0; i < count; ++i) {
+            newValues.resize((size + 1) * width);
+            if (!grounder.extend(literal, fact, boundBefore[level], values.data() + i * width,
+                                 newValues.data() + size * width)) {
+                newValues.resize(size * width);
+                continue;
+            }
+
+            const auto begin = atoms.begin() + static_cast<long>(i * level);
+            newAtoms.insert(newAtoms.end(), begin, begin + static_cast<long>(level));
+            newAtoms.emplace_back(candidate);
+            ++size;
+        }
+    }
+
+    memory.values[level].insert(memory.values[level].end(), newValues.begin(), newValues.end());
+    memory.atoms[level].insert(memory.atoms[level].end(), newAtoms.begin(), newAtoms.end());
+}
+
+void MatchNetwork::add(Memory &memory, AtomId atom) const {
+    const auto width = grounder.getVariables().size();
+    const auto &fact = AtomTable::get(atom);
+    std::vector<Term> values;
+    std::vector<AtomId> atoms;
+    std::vector<Term> nextValues;
+    std::vector<AtomId> nextAtoms;
+    for (std::size_t level = 0; level < order.size(); ++level) {
+        if (!admits(level, fact, atom)) {
+            continue;
+        }
+
+        memory.alpha[level].emplace_back(atom);
+        // the new partial matches end with atom at this level, they are joined with the alpha memories of the
+        // following levels. Matches that contain atom at a later level as well are created when that level is reached
+        if (level == 0) {
+            join(memory, level, std::vector<Term>(width), {}, 1, {atom}, values, atoms);
+        } else {
+            join(memory, level, memory.values[level - 1], memory.atoms[level - 1],
+                 memory.atoms[level - 1].size() / level, {atom}, values, atoms);
+        }
+
+        for (auto next = level + 1; next < order.size() && !atoms.empty(); ++next) {
+            join(memory, next, values, atoms, atoms.size() / next, memory.alpha[next], nextValues, nextAtoms);
+            std::swap(values, nextValues);
+            std::swap(atoms, nextAtoms);
+        }
+    }
+}
+
+void MatchNetwork::add(Memory &memory, const std::vector<AtomId> &atoms, ThreadPool &pool) const {
+    struct Seed {
+        std::size_t level;
+        AtomId atom;
+    };
+
+    const auto width = grounder.getVariables().size();
+    std::vector<std::size_t> oldCount(order.size());
+    std::vector<Seed> seeds;
+    for (std::size_t level = 0; level < order.size(); ++level) {
+        oldCount[level] = memory.atoms[level].size() / (level + 1);
+        for (auto atom : atoms) {
+            if (admits(level, AtomTable::get(atom), atom)) {
+                memory.alpha[level].emplace_back(atom);
+                seeds.push_back({level, atom});
+            }
+        }
+    }
+
+    // the tasks only read memory, every task writes the matches of its seed into its own memory
+    std::vector<Memory> found(seeds.size());
+    std::vector<ThreadPool::Task> tasks;
+    tasks.reserve(seeds.size());
+    for (std::size_t s = 0; s < seeds.size(); ++s) {
+        tasks.emplace_back([&, s](std::size_t) {
+            const auto [level, atom] = seeds[s];
+            auto &result = found[s];
+            result = empty();
+            std::vector<Term> values;
+            std::vector<AtomId> partial;
+            std::vector<Term> nextValues;
+            std::vector<AtomId> nextPartial;
+            if (level == 0) {
+                join(result, level, std::vector<Term>(width), {}, 1, {atom}, values, partial);
+            } else {
+                join(result, level, memory.values[level - 1], memory.atoms[level - 1], oldCount[level - 1], {atom},
+                     values, partial);
+            }
+
+            for (auto next = level + 1; next < order.size() && !partial.empty(); ++next) {
+                join(result, next, values, partial, partial.size() / next, memory.alpha[next], nextValues,
+                     nextPartial);
+                std::swap(values, nextValues);
+                std::swap(partial, nextPartial);
+            }
+        });
+    }
+
+    pool.run(std::move(tasks));
+    for (const auto &result : found) {
+        for (std::size_t level = 0; level < order.size(); ++level) {
+            memory.values[level].insert(memory.values[level].end(), result.values[level].begin(),
+                                        result.values[level].end());
+            memory.atoms[level].insert(memory.atoms[level].end(), result.atoms[level].begin(),
+                                       result.atoms[level].end());
+        }
+    }
+}
+
+bool MatchNetwork::admits(std::size_t level, const VariablePredicate &fact, AtomId atom) const {
+    return grounder.matches(grounder.getPreconditions()[order[level]], fact) &&
+           (!restricted || (atom < admitted[level].size() && admitted[level][atom]));
+}
+
+void MatchNetwork::remove(Memory &memory, const std::vector<AtomId> &deleted) const {
+    auto isDeleted = [&deleted](AtomId atom) {
+        return std::binary_search(deleted.begin(), deleted.end(), atom);
+    };
+
+    const auto width = grounder.getVariables().size();
+    for (std::size_t level = 0; level < order.size(); ++level) {
+        std::erase_if(memory.alpha[level], isDeleted);
+        auto &values = memory.values[level];
+        auto &atoms = memory.atoms[level];
+        const auto depth = level + 1;
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < atoms.size() / depth; ++i) {
+            const auto begin = atoms.begin() + static_cast<long>(i * depth);
+            if (std::any_of(begin, begin + static_cast<long>(depth), isDeleted)) {
+                continue;
+            }
+
+            std::copy(begin, begin + static_cast<long>(depth), atoms.begin() + static_cast<long>(kept * depth));
+            const auto row = values.begin() + static_cast<long>(i * width);
+            std::copy(row, row + static_cast<long>(width), values.begin() + static_cast<long>(kept * width));
+            ++kept;
+        }
+
+        atoms.resize(kept * depth);
+        values.resize(kept * width);
+    }
+}
+
+auto MatchNetwork::empty() const -> Memory {
+    return {std::vector<std::vector<AtomId>>(order.size()), std::vector<std::vector<Term>>(order.size()),
+            std::vector<std::vector<AtomId>>(order.size())};
+}
+
+auto MatchNetwork::match(const State &state) const -> Memory {
+    Memory memory = empty();
+    for (auto atom : state.getAtoms()) {
+        add(memory, atom);
+    }
+
+    return memory;
+}
+
+auto MatchNetwork::delta(const State &from, const State &to) -> Delta {
+    Delta ret;
+    std::set_difference(from.getAtoms().begin(), from.getAtoms().end(), to.getAtoms().begin(), to.getAtoms().end(),
+                        std::back_inserter(ret.deleted));
+    std::set_difference(to.getAtoms().begin(), to.getAtoms().end(), from.getAtoms().begin(), from.getAtoms().end(),
+                        std::back_inserter(ret.added));
+    return ret;
+}
+
+auto MatchNetwork::update(const Memory &parent, const Delta &delta) const -> Memory {
+    Memory memory = parent;
+    remove(memory, delta.deleted);
+    for (auto atom : delta.added) {
+        add(memory, atom);
+    }
+
+    return memory;
+}
+
+auto MatchNetwork::instantiate(const Memory &memory, const State &state) const -> std::vector<Operator> {
+    if (order.empty()) {
+        return {grounder.instantiate(nullptr)};
+    }
+
+    // first position of every atom as positive predicate of the state
+    std::unordered_map<AtomId, std::size_t> positions;
+    auto position = [&positions, &state](AtomId atom) {
+        auto [it, inserted] = positions.try_emplace(atom, 0);
+        if (inserted) {
+            for (auto i : state.occurrences(AtomTable::get(atom))) {
+                if (state.getPredicates()[i].getTruthVal()) {
+                    it->second = i;
+                    break;
+                }
+            }
+        }
+
+        return it->second;
+    };
+
+    const auto levels = order.size();
+    const auto &atoms = memory.atoms.back();
+    const auto count = atoms.size() / levels;
+    std::vector<std::size_t> keys(atoms.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t level = 0; level < levels; ++level) {
+            keys[i * levels + order[level]] = position(atoms[i * levels + level]);
+        }
+    }
+
+    std::vector<std::size_t> matches(count);
+    std::iota(matches.begin(), matches.end(), 0);
+    std::sort(matches.begin(), matches.end(), [&keys, levels](std::size_t a, std::size_t b) {
+        return std::lexicographical_compare(keys.begin() + static_cast<long>(a * levels),
+                                            keys.begin() + static_cast<long>((a + 1) * levels),
+                                            keys.begin() + static_cast<long>(b * levels),
+                                            keys.begin() + static_cast<long>((b + 1) * levels));
+    });
+
+    std::vector<Operator> ret;
+    ret.reserve(count);
+    for (auto i : matches) {
+        ret.emplace_back(instantiate(memory, i));
+    }
+
+    return ret;
+}
+
+auto MatchNetwork::size(const Memory &memory) const -> std::size_t {
+    if (order.empty()) {
+        return 1;
+    }
+
+    return memory.atoms.back().size() / order.size();
+}
+
+auto MatchNetwork::instantiate(const Memory &memory, std::size_t match) const -> Operator {
+    if (order.empty()) {
+        return grounder.instantiate(nullptr);
+    }
+
+    return grounder.instantiate(memory.values.back().data() + match * grounder.getVariables().size());
+}
+
+void MatchNetwork::restrict(const std::vector<Operator> &actions) {
+    const auto &preconditions = grounder.getPreconditions();
+    admitted.assign(order.size(), {});
+    for (const auto &action : actions) {
+        const auto &pre = action.getPreconditions();
+        if (action.getName() != grounder.getName() || pre.size() != preconditions.size()) {
+            continue;
+        }
+
+        for (std::size_t level = 0; level < order.size(); ++level) {
+            const auto &atom = pre[order[level]];
+            if (!atom.isAtomic()) {
+                continue;
+            }
+
+            const auto id = AtomTable::intern(atom, atom.atomHash());
+            if (id >= admitted[level].size()) {
+                admitted[level].resize(id + 1, false);
+            }
+
+            admitted[level][id] = true;
+        }
+    }
+
+    restricted = true;
+}
@@ -0,0 +1,143 @@
+#ifndef BLATT3_MATCHNETWORK_HPP
+#define BLATT3_MATCHNETWORK_HPP
+#include <vector>
+#include <cstddef>
+#include "Atom.hpp"
+#include "Grounder.hpp"
+#include "Operator.hpp"
+#include "State.hpp"
+
+class ThreadPool;
+
+/**
+ * RETE like match network of one operator. Every precondition is a level of the network. The memory of a state holds
+ * per level the atoms that match the precondition (alpha memory) and the partial matches of the preconditions up to
+ * this level (beta memory), the matches of the last level are the applicable instantiations. The memory of a
+ * successor is computed from the memory of its parent and the atoms the action deleted and added, so only the
+ * partial matches that contain a changed atom are touched. A search keeps the delta of every generated successor and
+ * computes its memory only when the successor is expanded.
+ * The network works on the canonical form of the states (closed world), so all preconditions must be positive
+ */
+class MatchNetwork {
+public:
+    struct Memory {
+        std::vector<std::vector<AtomId>> alpha;
+        // partial matches of every level: values by slot and the matched atom of every level up to this one
+        std::vector<std::vector<Term>> values;
+        std::vector<std::vector<AtomId>> atoms;
+    };
+
+    /**
+     * @param op
+     * @param injective if true, different variables are never bound to the same constant
+     * @throws std::invalid_argument if op has a negative precondition
+     */
+    MatchNetwork(const Operator &op, bool injective);
+
+    /**
+     * Memory without atoms
+     * @return
+     */
+    [[nodiscard]] auto empty() const -> Memory;
+
+    /**
+     * Computes the memory of state from scratch
+     * @param state
+     * @return
+     */
+    [[nodiscard]] auto match(const State &state) const -> Memory;
+
+    /**
+     * Atoms that an action deleted and added (sorted)
+     */
+    struct Delta {
+        std::vector<AtomId> deleted;
+        std::vector<AtomId> added;
+    };
+
+    /**
+     * @param from
+     * @param to
+     * @return the change of the canonical form from from to to
+     */
+    [[nodiscard]] static auto delta(const State &from, const State &to) -> Delta;
+
+    /**
+     * Memory of a successor
+     * @param parent memory of the parent
+     * @param delta change from the parent to the successor
+     * @return
+     */
+    [[nodiscard]] auto update(const Memory &parent, const Delta &delta) const -> Memory;
+
+    /**
+     * The applicable instantiations in the order of Operator::makeApplicable, without the duplicates it creates for
+     * duplicate predicates of the state
+     * @param memory memory of state
+     * @param state
+     * @return
+     */
+    [[nodiscard]] auto instantiate(const Memory &memory, const State &state) const -> std::vector<Operator>;
+
+    /**
+     * Adds an atom to a memory. Memories only grow by add, the new complete matches are appended to the old ones
+     * @param memory
+     * @param atom
+     */
+    void add(Memory &memory, AtomId atom) const;
+
+    /**
+     * Adds a batch of atoms, the memory gets the same matches as by add for every atom. The new matches are split by
+     * the first level whose atom belongs to the batch and by this atom: its task joins the partial matches that the
+     * level before had before the batch with the atom and the result with all atoms of the following levels. The tasks
+     * run on pool and their matches are appended in the order of the tasks, so the memory does not depend on the
+     * schedule
+     * @param memory
+     * @param atoms
+     * @param pool
+     */
+    void add(Memory &memory, const std::vector<AtomId> &atoms, ThreadPool &pool) const;
+
+    /**
+     * @param memory
+     * @return number of complete matches in memory
+     */
+    [[nodiscard]] auto size(const Memory &memory) const -> std::size_t;
+
+    /**
+     * @param memory
+     * @param match index of a complete match, less than size(memory)
+     * @return the instantiation of the operator by match
+     */
+    [[nodiscard]] auto instantiate(const Memory &memory, std::size_t match) const -> Operator;
+
+    /**
+     * Restricts the alpha memories to the atoms that a given ground action uses for the precondition of the level.
+     * Ground actions of other operators are ignored. If actions contains every instantiation that is applicable in
+     * some state (see Reachability), the complete matches of these states do not change
+     * @param actions ground instantiations of the operator
+     */
+    void restrict(const std::vector<Operator> &actions);
+
+private:
+    /**
+     * Joins count partial matches of level - 1 with the candidate atoms of level and appends the results to the
+     * memory of level
+     * @param newValues, newAtoms the new partial matches of level
+     */
+    void join(Memory &memory, std::size_t level, const std::vector<Term> &values, const std::vector<AtomId> &atoms,
+              std::size_t count, const std::vector<AtomId> &candidates, std::vector<Term> &newValues,
+              std::vector<AtomId> &newAtoms) const;
+    void remove(Memory &memory, const std::vector<AtomId> &deleted) const;
+    [[nodiscard]] bool admits(std::size_t level, const VariablePredicate &fact, AtomId atom) const;
+
+    Grounder grounder;
+    // precondition of every level and the slots bound by the levels before
+    std::vector<std::size_t> order;
+    std::vector<std::vector<bool>> boundBefore;
+    // atoms admitted to the alpha memory of every level if restricted, indexed by AtomId
+    std::vector<std::vector<bool>> admitted;
+    bool restricted = false;
+};
+
+#endif //BLATT3_MATCHNETWORK_HPP
@@ -6,12 +6,18 @@
 #include <cassert>
 #include <exception>
 #include <sstream>
-#include <list>
 #include "Operator.hpp"
+#include "Grounder.hpp"
 #include "util.hpp"
 
-Operator::Operator(std::string name, Operator::PredList preconditions, Operator::PredList effects) :
-        name(std::move(name)), preconditions(std::move(preconditions)), effects(std::move(effects)) {}
+Operator::Operator(std::string name, Operator::PredList preconditions, Operator::PredList effects,
+                   const Parameters &types) :
+        name(std::move(name)), preconditions(std::move(preconditions)), effects(std::move(effects)) {
+    for (const auto &[variable, type] : types) {
+        this->types.emplace_back(Term(variable), SymbolTable::intern(type));
+        assert(this->types.back().first.isVariable());
+    }
+}
 
 void Operator::applySubstitution(const VariablePredicate::Substitution &substitution) {
     for (auto &v : preconditions) {
@@ -38,7 +44,7 @@ auto Operator::variableNames() const -> std::set<std::string> {
     auto insertNames = [&ret](const PredList &predList) {
         for (const auto &pred : predList) {
             for (const auto &v : pred.getVariables()) {
-                ret.emplace(v);
+                ret.emplace(v.getName());
             }
         }
     };
@@ -48,66 +54,22 @@ auto Operator::variableNames() const -> std::set<std::string> {
     return ret;
 }
 
-void
-Operator::makeApplicable(const Operator::PossiblePreconditions &precondPossibilities, const Operator &op, std::size_t i,
-                         std::vector<Operator> &instantiations, const std::set<std::string> &substitutedValues,
-                         bool allowDoubleSubstitution) {
-
-    if (i == op.getPreconditions().size()) {
-        instantiations.emplace_back(op);
-        return;
-    }
-
-    const auto &currReq = op.getPreconditions()[i];
-    const auto &currentPossibilities = precondPossibilities[i];
-    for (const auto &pred : currentPossibilities) {
-        auto subs = findSubstitution(currReq, pred);
-        if (subs.has_value()) {
-            auto newSubsVals = substitutedValues;
-            if (!allowDoubleSubstitution) {
-                bool doubleSubstitution = false;
-                for (const auto &[oldVal, newVal] : subs->first) {
-                    if (newSubsVals.contains(newVal)) {
-                        doubleSubstitution = true;
-                        break;
-                    } else {
-                        newSubsVals.emplace(newVal);
-                    }
-                }
-
-                if (doubleSubstitution) {
-                    continue;
-                }
-            }
-
-            Operator substituted = op;
-            substituted.applySubstitution(subs->first);
-            makeApplicable(precondPossibilities, substituted, i + 1, instantiations, newSubsVals,
-                           allowDoubleSubstitution);
-        }
-    }
-}
-
 auto Operator::makeApplicable(const State &state, bool allowDoubleSubstitution) const -> std::vector<Operator> {
+    const Grounder grounder(*this, !allowDoubleSubstitution);
+    const auto bindings = grounder.ground(state);
     std::vector<Operator> ret;
-    PossiblePreconditions possibleConditions(preconditions.size());
-    for (std::size_t i = 0; i < preconditions.size(); ++i) {
-        for (const auto &pred : state.getPredicates()) {
-            if (pred.typeEqual(preconditions[i]) && pred.getTruthVal() == preconditions[i].getTruthVal()) {
-                possibleConditions[i].emplace_back(pred);
-            }
-        }
+    ret.reserve(bindings.size);
+    for (std::size_t i = 0; i < bindings.size; ++i) {
+        ret.emplace_back(grounder.instantiate(bindings[i]));
     }
 
-    if (std::any_of(possibleConditions.begin(), possibleConditions.end(),
-                    [](const auto &set) { return set.empty(); })) {
-        return ret;
-    }
-
-    makeApplicable(possibleConditions, *this, 0, ret, {}, allowDoubleSubstitution);
     return ret;
 }
 
+auto Operator::getName() const -> const std::string & {
+    return name;
+}
+
 auto Operator::getPreconditions() const -> const Operator::PredList & {
     return preconditions;
 }
@@ -116,6 +78,10 @@ auto Operator::getEffects() const -> const Operator::PredList & {
     return effects;
 }
 
+auto Operator::getTypes() const -> const std::vector<std::pair<Term, Symbol>> & {
+    return types;
+}
+
 bool Operator::isAtomic() const {
     return std::all_of(preconditions.begin(), preconditions.end(),
                        [](const auto &elem) { return elem.isAtomic(); }) &&
@@ -138,27 +104,37 @@ State Operator::applyTo(const State &state) const {
     opName << *this;
     actionSeq.append(opName.str());
     const auto &oldPreds = state.getPredicates();
-    PredList preds;
-    preds.reserve(oldPreds.size());
-    std::list tmpEffects(effects.begin(), effects.end());
-    for (const auto &oPred : oldPreds) {
-        auto res = std::find_if(tmpEffects.begin(), tmpEffects.end(), [&oPred] (const auto &eff) {
-            return eff.atomicEqual(oPred);
-        });
-
-        if (res == tmpEffects.end()) {
-            preds.emplace_back(oPred);
-        } else {
-            if (res->getTruthVal() || !oPred.getTruthVal()) {
-                preds.emplace_back(std::move(*res));
-            }
+    // the k-th effect on an atom replaces the k-th predicate of the state with that atom, the other effects are
+    // appended
+    constexpr auto NoEffect = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> replacedBy(oldPreds.size(), NoEffect);
+    std::vector<bool> replacing(effects.size(), false);
+    for (std::size_t j = 0; j < effects.size(); ++j) {
+        const auto k = static_cast<std::size_t>(std::count_if(effects.begin(), effects.begin() + static_cast<long>(j),
+                                                              [this, j](const auto &e) {
+                                                                  return e.atomicEqual(effects[j]);
+                                                              }));
+        const auto positions = state.occurrences(effects[j]);
+        if (k < positions.size()) {
+            replacedBy[positions[k]] = j;
+            replacing[j] = true;
+        }
+    }
 
-            tmpEffects.erase(res);
+    PredList preds;
+    preds.reserve(oldPreds.size() + effects.size());
+    for (std::size_t i = 0; i < oldPreds.size(); ++i) {
+        if (replacedBy[i] == NoEffect) {
+            preds.emplace_back(oldPreds[i]);
+        } else if (effects[replacedBy[i]].getTruthVal() || !oldPreds[i].getTruthVal()) {
+            preds.emplace_back(effects[replacedBy[i]]);
         }
     }
 
-    for (auto &eff : tmpEffects) {
-        preds.emplace_back(std::move(eff));
+    for (std::size_t j = 0; j < effects.size(); ++j) {
+        if (!replacing[j]) {
+            preds.emplace_back(effects[j]);
+        }
     }
 
     return State(std::move(preds), std::move(actionSeq));
@@ -170,10 +146,6 @@ bool Operator::applicableTo(const State &state) const {
     }
 
     return std::all_of(preconditions.begin(), preconditions.end(), [&state] (const auto &cond) {
-        auto res = std::find_if(state.getPredicates().begin(), state.getPredicates().end(), [&cond] (const auto &pred) {
-            return pred.fullEqual(cond);
-        });
-
-        return res != state.getPredicates().end();
+        return state.contains(cond);
     });
 }
@@ -15,14 +15,35 @@
 class Operator {
 public:
     using PredList = State::PredList;
-    using PossiblePreconditions = std::vector<PredList>;
-    Operator(std::string name, PredList preconditions, PredList effects);
+
+    /**
+     * Pairs of variable and type name
+     */
+    using Parameters = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * @param name
+     * @param preconditions
+     * @param effects
+     * @param types types of the variables, a variable without type can be bound to every constant, a typed one only
+     * to the constants of its type (see TypeTable)
+     */
+    Operator(std::string name, PredList preconditions, PredList effects, const Parameters &types = {});
     void applySubstitution(const VariablePredicate::Substitution &substitution);
     [[nodiscard]] auto variableNames() const -> std::set<std::string>;
+
+    /**
+     * All instantiations of this operator whose preconditions are facts of state, computed by the Grounder
+     * @param state
+     * @param allowDoubleSubstitution if false, different variables are never substituted by the same constant
+     * @return
+     */
     [[nodiscard]] auto makeApplicable(const State &state, bool allowDoubleSubstitution = true) const
         -> std::vector<Operator>;
+    [[nodiscard]] auto getName() const -> const std::string &;
     [[nodiscard]] auto getPreconditions() const -> const PredList &;
     [[nodiscard]] auto getEffects() const -> const PredList &;
+    [[nodiscard]] auto getTypes() const -> const std::vector<std::pair<Term, Symbol>> &;
     [[nodiscard]] bool isAtomic() const;
     [[nodiscard]] State applyTo(const State &state) const;
     [[nodiscard]] bool applicableTo(const State &state) const;
@@ -31,12 +52,8 @@ private:
     std::string name;
     PredList preconditions;
     PredList effects;
+    std::vector<std::pair<Term, Symbol>> types;
     friend std::ostream &operator<<(std::ostream &out, const Operator &o);
-
-    static void
-    makeApplicable(const Operator::PossiblePreconditions &precondPossibilities, const Operator &op, std::size_t i,
-                   std::vector<Operator> &instantiations, const std::set<std::string> &substitutedValues,
-                   bool allowDoubleSubstitution);
 };
 
 std::ostream &operator<<(std::ostream &out, const Operator &o);
@@ -0,0 +1,245 @@
+#include "Reachability.hpp"
+#include "MatchNetwork.hpp"
+#include "ThreadPool.hpp"
+#include "Type.hpp"
+#include <algorithm>
+#include <iterator>
+#include <fstream>
+#include <sstream>
+#include <set>
+#include <unordered_set>
+
+namespace {
+    constexpr std::size_t ChunkSize = 256;
+
+    void write(std::ostream &out, const VariablePredicate &pred) {
+        out << " " << pred.getName() << " " << (pred.getTruthVal() ? "+" : "-") << " " << pred.getVariables().size();
+        for (const auto &arg : pred.getVariables()) {
+            out << " " << arg.getName();
+        }
+    }
+
+    auto read(std::istream &in, State::PredList &preds) -> bool {
+        std::size_t count;
+        if (!(in >> count)) {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string name;
+            std::string sign;
+            std::size_t arity;
+            if (!(in >> name >> sign >> arity) || (sign != "+" && sign != "-")) {
+                return false;
+            }
+
+            std::vector<std::string> args(arity);
+            for (auto &arg : args) {
+                if (!(in >> arg)) {
+                    return false;
+                }
+            }
+
+            preds.emplace_back(name, args, sign == "+");
+        }
+
+        return true;
+    }
+}
+
+Reachability::Reachability(const std::vector<Operator> &operators, const State &init, bool injective,
+                           ThreadPool &pool) : key(makeKey(operators, init, injective)) {
+    std::vector<MatchNetwork> networks;
+    std::vector<MatchNetwork::Memory> memories;
+    for (const auto &op : operators) {
+        networks.emplace_back(op, injective);
+        memories.emplace_back(networks.back().empty());
+    }
+
+    // the atoms are added layer by layer, the join of every network is split across the pool (see MatchNetwork::add).
+    // The effects are interned after the layer in the order of the operators, so the result does not depend on the
+    // schedule
+    std::vector<AtomId> reached(init.getAtoms());
+    std::unordered_set<AtomId> seen(reached.begin(), reached.end());
+    std::vector<std::size_t> done(networks.size(), 0);
+    std::vector<std::vector<Operator>> found(networks.size());
+    // the new matches are instantiated in chunks on the pool and appended in the order of the chunks
+    auto collect = [&](std::size_t i) {
+        const auto end = networks[i].size(memories[i]);
+        std::vector<std::vector<Operator>> chunks((end - done[i] + ChunkSize - 1) / ChunkSize);
+        std::vector<ThreadPool::Task> tasks;
+        for (std::size_t c = 0; c < chunks.size(); ++c) {
+            tasks.emplace_back([&, i, c, end](std::size_t) {
+                const auto begin = done[i] + c * ChunkSize;
+                for (auto m = begin; m < std::min(end, begin + ChunkSize); ++m) {
+                    chunks[c].emplace_back(networks[i].instantiate(memories[i], m));
+                }
+            });
+        }
+
+        pool.run(std::move(tasks));
+        for (auto &chunk : chunks) {
+            std::move(chunk.begin(), chunk.end(), std::back_inserter(found[i]));
+        }
+
+        done[i] = end;
+    };
+
+    std::size_t layerBegin = 0;
+    for (std::size_t i = 0; i < networks.size(); ++i) {
+        collect(i);
+    }
+
+    while (true) {
+        for (auto &ops : found) {
+            for (auto &action : ops) {
+                for (const auto &effect : action.getEffects()) {
+                    if (effect.getTruthVal() && effect.isAtomic()) {
+                        const auto id = AtomTable::intern(effect, effect.atomHash());
+                        if (seen.insert(id).second) {
+                            reached.emplace_back(id);
+                        }
+                    }
+                }
+
+                actions.emplace_back(std::move(action));
+            }
+
+            ops.clear();
+        }
+
+        if (layerBegin == reached.size()) {
+            break;
+        }
+
+        const std::vector<AtomId> layer(reached.begin() + static_cast<long>(layerBegin), reached.end());
+        for (std::size_t i = 0; i < networks.size(); ++i) {
+            networks[i].add(memories[i], layer, pool);
+            collect(i);
+        }
+
+        layerBegin = reached.size();
+    }
+
+    atoms = std::move(reached);
+    std::sort(atoms.begin(), atoms.end());
+}
+
+Reachability::Reachability(std::string key, std::vector<Operator> actions, const State &init) :
+        key(std::move(key)), actions(std::move(actions)) {
+    collectAtoms(init);
+}
+
+void Reachability::collectAtoms(const State &init) {
+    atoms = init.getAtoms();
+    for (const auto &action : actions) {
+        for (const auto &effect : action.getEffects()) {
+            if (effect.getTruthVal() && effect.isAtomic()) {
+                atoms.emplace_back(AtomTable::intern(effect, effect.atomHash()));
+            }
+        }
+    }
+
+    std::sort(atoms.begin(), atoms.end());
+    atoms.erase(std::unique(atoms.begin(), atoms.end()), atoms.end());
+}
+
+auto Reachability::makeKey(const std::vector<Operator> &operators, const State &init, bool injective)
+    -> std::string {
+    std::stringstream ret;
+    ret << "reachability " << (injective ? "injective" : "any");
+    std::set<Symbol> types;
+    for (const auto &op : operators) {
+        ret << " " << op;
+        for (const auto &[variable, type] : op.getTypes()) {
+            ret << " " << variable << ":" << SymbolTable::name(type);
+            types.emplace(type);
+        }
+    }
+
+    ret << " " << init;
+    for (const auto &constant : init.constants()) {
+        for (auto type : types) {
+            if (TypeTable::isA(Term(constant), type)) {
+                ret << " " << constant << ":" << SymbolTable::name(type);
+            }
+        }
+    }
+    auto str = ret.str();
+    std::replace(str.begin(), str.end(), '\n', ' ');
+    return str;
+}
+
+auto Reachability::cached(const std::string &cacheFile, const std::vector<Operator> &operators, const State &init,
+                          bool injective, ThreadPool &pool) -> Reachability {
+    if (std::ifstream in(cacheFile); in) {
+        if (auto ret = load(in, operators, init, injective)) {
+            return std::move(*ret);
+        }
+    }
+
+    Reachability ret(operators, init, injective, pool);
+    std::ofstream out(cacheFile);
+    ret.save(out);
+    return ret;
+}
+
+auto Reachability::getAtoms() const -> const std::vector<AtomId> & {
+    return atoms;
+}
+
+auto Reachability::getActions() const -> const std::vector<Operator> & {
+    return actions;
+}
+
+bool Reachability::isReachable(AtomId atom) const {
+    return std::binary_search(atoms.begin(), atoms.end(), atom);
+}
+
+bool Reachability::mayReach(const State &goal) const {
+    return std::all_of(goal.getAtoms().begin(), goal.getAtoms().end(), [this](AtomId atom) {
+        return isReachable(atom);
+    });
+}
+
+void Reachability::save(std::ostream &out) const {
+    out << key << "\n" << actions.size() << "\n";
+    for (const auto &action : actions) {
+        out << action.getName() << " " << action.getPreconditions().size();
+        for (const auto &pre : action.getPreconditions()) {
+            write(out, pre);
+        }
+
+        out << " " << action.getEffects().size();
+        for (const auto &eff : action.getEffects()) {
+            write(out, eff);
+        }
+
+        out << "\n";
+    }
+}
+
+auto Reachability::load(std::istream &in, const std::vector<Operator> &operators, const State &init, bool injective)
+    -> std::optional<Reachability> {
+    std::string storedKey;
+    auto expected = makeKey(operators, init, injective);
+    std::size_t count;
+    if (!std::getline(in, storedKey) || storedKey != expected || !(in >> count)) {
+        return std::nullopt;
+    }
+
+    std::vector<Operator> actions;
+    actions.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::string name;
+        State::PredList preconditions;
+        State::PredList effects;
+        if (!(in >> name) || !read(in, preconditions) || !read(in, effects)) {
+            return std::nullopt;
+        }
+
+        actions.emplace_back(std::move(name), std::move(preconditions), std::move(effects));
+    }
+
+    return Reachability(std::move(expected), std::move(actions), init);
+}
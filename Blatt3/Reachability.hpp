@@ -0,0 +1,92 @@
+#ifndef BLATT3_REACHABILITY_HPP
+#define BLATT3_REACHABILITY_HPP
+#include <vector>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <optional>
+#include "Atom.hpp"
+#include "Operator.hpp"
+#include "State.hpp"
+
+class ThreadPool;
+
+/**
+ * Relaxed reachability analysis: the fixpoint of applying the operators without their negative effects, starting
+ * from an initial state. Every atom of a reachable state is a reachable atom and every instantiation that is
+ * applicable in a reachable state is a reachable action, so the search can be restricted to them. The fixpoint is
+ * computed semi naively with one MatchNetwork per operator: every reached atom is added once and only the matches
+ * that contain it are joined. The atoms are added layer by layer, the new matches of a layer are joined in parallel
+ */
+class Reachability {
+public:
+    /**
+     * @param operators operators with positive preconditions only
+     * @param init
+     * @param injective if true, different variables are never bound to the same constant
+     * @param pool runs the joins of the networks, one task per atom of a layer and precondition it matches
+     * @throws std::invalid_argument if an operator has a negative precondition
+     */
+    Reachability(const std::vector<Operator> &operators, const State &init, bool injective, ThreadPool &pool);
+
+    /**
+     * Loads the analysis from cacheFile if it was written for the same operators, types, initial state and
+     * injectivity, otherwise computes it and writes it to cacheFile
+     * @param cacheFile
+     * @param operators
+     * @param init
+     * @param injective
+     * @param pool
+     * @return
+     */
+    static auto cached(const std::string &cacheFile, const std::vector<Operator> &operators, const State &init,
+                       bool injective, ThreadPool &pool) -> Reachability;
+
+    /**
+     * @return the reachable atoms, sorted
+     */
+    [[nodiscard]] auto getAtoms() const -> const std::vector<AtomId> &;
+
+    /**
+     * @return the reachable ground actions in the order they were reached
+     */
+    [[nodiscard]] auto getActions() const -> const std::vector<Operator> &;
+
+    [[nodiscard]] bool isReachable(AtomId atom) const;
+
+    /**
+     * True if every positive predicate of goal is a reachable atom
+     * @param goal must be atomic
+     * @return
+     */
+    [[nodiscard]] bool mayReach(const State &goal) const;
+
+    /**
+     * Writes the analysis as text: the key of the input, the number of actions and every action as name,
+     * preconditions and effects, each predicate as name, sign, arity and arguments
+     * @param out
+     */
+    void save(std::ostream &out) const;
+
+    /**
+     * @param in
+     * @param operators
+     * @param init
+     * @param injective
+     * @return the analysis written by save if it was computed for the same input, otherwise std::nullopt
+     */
+    static auto load(std::istream &in, const std::vector<Operator> &operators, const State &init, bool injective)
+        -> std::optional<Reachability>;
+
+private:
+    Reachability(std::string key, std::vector<Operator> actions, const State &init);
+    [[nodiscard]] static auto makeKey(const std::vector<Operator> &operators, const State &init, bool injective)
+        -> std::string;
+    void collectAtoms(const State &init);
+
+    std::string key;
+    std::vector<AtomId> atoms;
+    std::vector<Operator> actions;
+};
+
+#endif //BLATT3_REACHABILITY_HPP
@@ -5,9 +5,50 @@
 #include "State.hpp"
 #include "util.hpp"
 #include <algorithm>
+#include <bit>
 
 State::State(PredList predicates, std::string actionSeq) : predicates(std::move(predicates)),
-    actionSeq(std::move(actionSeq)) {}
+    actionSeq(std::move(actionSeq)) {
+    atomic = std::all_of(this->predicates.begin(), this->predicates.end(),
+                         [](const auto &elem) { return elem.isAtomic(); });
+    table.resize(std::bit_ceil(std::max<std::size_t>(2 * this->predicates.size(), 8)));
+    const auto mask = table.size() - 1;
+    for (std::size_t i = 0; i < this->predicates.size(); ++i) {
+        const auto &pred = this->predicates[i];
+        buckets[pred.getSymbol()].emplace_back(i);
+        if (!pred.isAtomic()) {
+            continue;
+        }
+
+        const auto atomHash = pred.atomHash();
+        auto slot = atomHash & mask;
+        while (table[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+
+        table[slot] = static_cast<std::uint32_t>(i + 1);
+        if (pred.getTruthVal()) {
+            atoms.emplace_back(AtomTable::intern(pred, atomHash));
+        }
+    }
+
+    std::sort(atoms.begin(), atoms.end());
+    atoms.erase(std::unique(atoms.begin(), atoms.end()), atoms.end());
+    for (auto id : atoms) {
+        hash ^= AtomTable::key(id);
+    }
+}
+
+template<typename F>
+void State::probe(const VariablePredicate &atom, F &&f) const {
+    const auto mask = table.size() - 1;
+    for (auto slot = atom.atomHash() & mask; table[slot] != 0; slot = (slot + 1) & mask) {
+        const auto &pred = predicates[table[slot] - 1];
+        if (pred.getSymbol() == atom.getSymbol() && pred.getVariables() == atom.getVariables()) {
+            f(table[slot] - 1);
+        }
+    }
+}
 
 auto State::getPredicates() const -> const State::PredList & {
     return predicates;
@@ -23,11 +64,29 @@ auto State::constants() const -> std::set<std::string> {
 }
 
 bool State::isAtomic() const {
-    return std::all_of(predicates.begin(), predicates.end(), [](const auto &elem) { return elem.isAtomic(); });
+    return atomic;
 }
 
-auto State::getPredicates() -> State::PredList & {
-    return predicates;
+bool State::contains(const VariablePredicate &literal) const {
+    bool found = false;
+    probe(literal, [this, &literal, &found](std::size_t i) {
+        found = found || predicates[i].getTruthVal() == literal.getTruthVal();
+    });
+
+    return found;
+}
+
+auto State::occurrences(const VariablePredicate &atom) const -> std::vector<std::size_t> {
+    std::vector<std::size_t> ret;
+    probe(atom, [&ret](std::size_t i) { ret.emplace_back(i); });
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+auto State::getBucket(Symbol predicate) const -> const std::vector<std::size_t> & {
+    static const std::vector<std::size_t> empty;
+    auto it = buckets.find(predicate);
+    return it == buckets.end() ? empty : it->second;
 }
 
 std::ostream &operator<<(std::ostream &out, const State &state) {
@@ -43,20 +102,18 @@ auto State::getActionSequence() const -> const std::string & {
 bool State::isSolutionOf(const State &state) const {
     return isAtomic() && state.isAtomic() &&
         std::all_of(state.getPredicates().begin(), state.getPredicates().end(), [this] (const auto &pred) {
-            auto res = std::find_if(predicates.begin(), predicates.end(), [&pred] (const auto &tPred) {
-                return tPred.fullEqual(pred);
-            });
-
-            return res != predicates.end();
+            return contains(pred);
         });
 }
 
-bool State::operator==(const State &other) const {
-    return std::all_of(predicates.begin(), predicates.end(), [&other] (const auto &pred) {
-        auto res = std::find_if(other.predicates.begin(), other.predicates.end(), [&pred] (const auto &oPred) {
-            return oPred.fullEqual(pred);
-        });
+auto State::getAtoms() const -> const std::vector<AtomId> & {
+    return atoms;
+}
 
-        return res != other.predicates.end() || !pred.getTruthVal();
-    });
+auto State::getHash() const -> std::uint64_t {
+    return hash;
+}
+
+bool State::operator==(const State &other) const {
+    return hash == other.hash && atoms == other.atoms;
 }
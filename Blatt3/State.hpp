@@ -8,22 +8,80 @@
 #include <set>
 #include <string>
 #include <ostream>
+#include <cstdint>
+#include <unordered_map>
 #include "VariablePredicate.hpp"
+#include "Atom.hpp"
 
+/**
+ * List of predicates with an index: a hash table from atom (name and arguments) to the positions of the predicates
+ * and the positions of the predicates per name. Membership tests take expected O(1) per predicate.
+ * The canonical form of a state is the sorted set of the interned atoms of its positive predicates (closed world
+ * assumption: negative predicates and duplicates do not matter), two states are equal iff their canonical forms are.
+ * The 64 bit hash of the canonical form is computed once on construction
+ */
 class State {
 public:
+    struct Hash {
+        std::size_t operator()(const State &s) const {
+            return s.getHash();
+        }
+    };
+
     using PredList = std::vector<VariablePredicate>;
     explicit State(PredList predicates, std::string predList = "");
     [[nodiscard]] auto getPredicates() const -> const PredList &;
-    [[nodiscard]] auto getPredicates() -> PredList &;
     [[nodiscard]] auto constants() const -> std::set<std::string>;
     [[nodiscard]] bool isAtomic() const;
     [[nodiscard]] auto getActionSequence() const -> const std::string &;
     [[nodiscard]] bool isSolutionOf(const State &state) const;
+
+    /**
+     * True if a predicate of this state is fullEqual to literal
+     * @param literal must be atomic
+     * @return
+     */
+    [[nodiscard]] bool contains(const VariablePredicate &literal) const;
+
+    /**
+     * Positions of all predicates that are atomicEqual to atom (regardless of their truth value) in ascending order
+     * @param atom must be atomic
+     * @return
+     */
+    [[nodiscard]] auto occurrences(const VariablePredicate &atom) const -> std::vector<std::size_t>;
+
+    /**
+     * Positions of all predicates with the given name in ascending order
+     * @param predicate
+     * @return
+     */
+    [[nodiscard]] auto getBucket(Symbol predicate) const -> const std::vector<std::size_t> &;
+
+    /**
+     * Canonical form: sorted ids of the atoms of the positive predicates without duplicates
+     * @return
+     */
+    [[nodiscard]] auto getAtoms() const -> const std::vector<AtomId> &;
+    [[nodiscard]] auto getHash() const -> std::uint64_t;
+
+    /**
+     * Compares the hashes first, the canonical forms only on a hash collision
+     * @param other
+     * @return
+     */
     bool operator==(const State &other) const;
 private:
+    template<typename F>
+    void probe(const VariablePredicate &atom, F &&f) const;
+
     PredList predicates;
     std::string actionSeq;
+    bool atomic;
+    // open addressing table of position + 1 of the atomic predicates, 0 marks a free entry
+    std::vector<std::uint32_t> table;
+    std::unordered_map<Symbol, std::vector<std::size_t>> buckets;
+    std::vector<AtomId> atoms;
+    std::uint64_t hash = 0;
 };
 
 std::ostream &operator<<(std::ostream &out, const State &state);
@@ -0,0 +1,47 @@
+#include "Symbol.hpp"
+#include <deque>
+#include <unordered_map>
+#include <cassert>
+
+namespace {
+    struct Symbols {
+        // a deque keeps the names at their address, the keys of ids are views into it
+        std::deque<std::string> names;
+        std::unordered_map<std::string_view, Symbol> ids;
+    };
+
+    auto symbols() -> Symbols & {
+        static Symbols table;
+        return table;
+    }
+}
+
+auto SymbolTable::intern(std::string_view name) -> Symbol {
+    auto &table = symbols();
+    auto it = table.ids.find(name);
+    if (it != table.ids.end()) {
+        return it->second;
+    }
+
+    const auto symbol = static_cast<Symbol>(table.names.size());
+    table.names.emplace_back(name);
+    table.ids.emplace(table.names.back(), symbol);
+    return symbol;
+}
+
+auto SymbolTable::name(Symbol symbol) -> const std::string & {
+    const auto &table = symbols();
+    assert(symbol < table.names.size());
+    return table.names[symbol];
+}
+
+Term::Term(std::string_view name) : value(SymbolTable::intern(name)) {
+    assert((value & VariableBit) == 0);
+    if (name.starts_with('<') && name.ends_with('>')) {
+        value |= VariableBit;
+    }
+}
+
+std::ostream &operator<<(std::ostream &out, const Term &t) {
+    return out << t.getName();
+}
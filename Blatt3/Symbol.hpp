@@ -0,0 +1,80 @@
+#ifndef BLATT3_SYMBOL_HPP
+#define BLATT3_SYMBOL_HPP
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <ostream>
+
+using Symbol = std::uint32_t;
+
+/**
+ * Interns all predicate names, constants and variables of the program. Every distinct name is stored once and
+ * identified by a dense Symbol, so names are compared and hashed as integers. Symbols are never removed
+ */
+class SymbolTable {
+public:
+    /**
+     * @param name
+     * @return the symbol of name, a new one if name was not interned before
+     */
+    static auto intern(std::string_view name) -> Symbol;
+
+    /**
+     * @param symbol must have been returned by intern
+     * @return
+     */
+    static auto name(Symbol symbol) -> const std::string &;
+};
+
+/**
+ * Argument of a predicate: an interned symbol tagged as variable or constant. Names in angle brackets (e.g. <X>) are
+ * variables, all other names are constants
+ */
+class Term {
+public:
+    struct Hash {
+        std::size_t operator()(const Term &t) const {
+            return t.value;
+        }
+    };
+
+    Term() = default;
+
+    explicit Term(std::string_view name);
+
+    static auto variable(Symbol symbol) -> Term {
+        return Term(symbol | VariableBit);
+    }
+
+    static auto constant(Symbol symbol) -> Term {
+        return Term(symbol);
+    }
+
+    [[nodiscard]] bool isVariable() const {
+        return (value & VariableBit) != 0;
+    }
+
+    [[nodiscard]] auto getSymbol() const -> Symbol {
+        return value & ~VariableBit;
+    }
+
+    [[nodiscard]] auto getName() const -> const std::string & {
+        return SymbolTable::name(getSymbol());
+    }
+
+    bool operator==(const Term &other) const = default;
+
+    auto operator<=>(const Term &other) const = default;
+
+private:
+    static constexpr std::uint32_t VariableBit = 1u << 31u;
+
+    explicit Term(std::uint32_t value) : value(value) {}
+
+    std::uint32_t value = 0;
+};
+
+std::ostream &operator<<(std::ostream &out, const Term &t);
+
+#endif //BLATT3_SYMBOL_HPP
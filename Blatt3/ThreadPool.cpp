@@ -0,0 +1,121 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <utility>
+
+ThreadPool::ThreadPool(std::size_t numWorkers) {
+    if (numWorkers == 0) {
+        numWorkers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (std::size_t i = 0; i < numWorkers; ++i) {
+        queues.emplace_back(std::make_unique<Queue>());
+    }
+
+    for (std::size_t i = 1; i < numWorkers; ++i) {
+        threads.emplace_back([this, i] { loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stop = true;
+    }
+
+    wake.notify_all();
+    for (auto &t : threads) {
+        t.join();
+    }
+}
+
+auto ThreadPool::size() const -> std::size_t {
+    return queues.size();
+}
+
+bool ThreadPool::pop(std::size_t worker, Task &task) {
+    {
+        auto &own = *queues[worker];
+        std::lock_guard lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for (std::size_t i = 1; i < queues.size(); ++i) {
+        auto &other = *queues[(worker + i) % queues.size()];
+        std::lock_guard lock(other.mutex);
+        if (!other.tasks.empty()) {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::work(std::size_t worker) {
+    Task task;
+    while (pop(worker, task)) {
+        try {
+            task(worker);
+        } catch (...) {
+            std::lock_guard lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+
+        task = nullptr;
+        if (pending.fetch_sub(1) == 1) {
+            std::lock_guard lock(mutex);
+            done.notify_all();
+        }
+    }
+}
+
+void ThreadPool::loop(std::size_t worker) {
+    std::size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock lock(mutex);
+            wake.wait(lock, [this, seen] { return stop || batch != seen; });
+            if (stop) {
+                return;
+            }
+
+            seen = batch;
+        }
+
+        work(worker);
+    }
+}
+
+void ThreadPool::run(std::vector<Task> tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    pending = tasks.size();
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        auto &queue = *queues[i % queues.size()];
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.emplace_back(std::move(tasks[i]));
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        ++batch;
+    }
+
+    wake.notify_all();
+    work(0);
+    std::unique_lock lock(mutex);
+    done.wait(lock, [this] { return pending == 0; });
+    if (error) {
+        auto e = std::exchange(error, nullptr);
+        std::rethrow_exception(e);
+    }
+}
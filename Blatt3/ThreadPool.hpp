@@ -0,0 +1,64 @@
+#ifndef BLATT3_THREADPOOL_HPP
+#define BLATT3_THREADPOOL_HPP
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <exception>
+#include <cstddef>
+
+/**
+ * Work stealing thread pool. Every worker has its own task queue, it takes tasks from the back of its own queue and
+ * steals from the front of the other queues when its own queue is empty. The thread that calls run is worker 0, so a
+ * pool of size 1 runs all tasks in the calling thread
+ */
+class ThreadPool {
+public:
+    /**
+     * Task of a batch, gets the index of the worker that runs it (less than size()) to access per worker buffers
+     */
+    using Task = std::function<void(std::size_t worker)>;
+
+    /**
+     * @param numWorkers number of workers including the calling thread, 0 for the hardware concurrency
+     */
+    explicit ThreadPool(std::size_t numWorkers = 0);
+    ThreadPool(const ThreadPool &) = delete;
+    auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+    ~ThreadPool();
+
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    /**
+     * Runs a batch of tasks and returns when all of them are done. Task i is queued at worker i % size(). If tasks
+     * throw, the first exception is rethrown after the batch
+     * @param tasks
+     */
+    void run(std::vector<Task> tasks);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    [[nodiscard]] bool pop(std::size_t worker, Task &task);
+    void work(std::size_t worker);
+    void loop(std::size_t worker);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::size_t batch = 0;
+    bool stop = false;
+    std::atomic_size_t pending = 0;
+    std::exception_ptr error;
+};
+
+#endif //BLATT3_THREADPOOL_HPP
@@ -0,0 +1,38 @@
+#include "Type.hpp"
+#include <vector>
+#include <cassert>
+
+namespace {
+    // members[type][object] for the symbols of types and constants
+    auto members() -> std::vector<std::vector<bool>> & {
+        static std::vector<std::vector<bool>> table;
+        return table;
+    }
+}
+
+void TypeTable::declare(std::string_view object, std::string_view type) {
+    const Term constant(object);
+    assert(!constant.isVariable());
+    const auto typeSymbol = SymbolTable::intern(type);
+    auto &table = members();
+    if (typeSymbol >= table.size()) {
+        table.resize(typeSymbol + 1);
+    }
+
+    auto &objects = table[typeSymbol];
+    if (constant.getSymbol() >= objects.size()) {
+        objects.resize(constant.getSymbol() + 1, false);
+    }
+
+    objects[constant.getSymbol()] = true;
+}
+
+bool TypeTable::isA(Term object, Symbol type) {
+    const auto &table = members();
+    if (object.isVariable() || type >= table.size()) {
+        return false;
+    }
+
+    const auto &objects = table[type];
+    return object.getSymbol() < objects.size() && objects[object.getSymbol()];
+}
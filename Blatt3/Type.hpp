@@ -0,0 +1,28 @@
+#ifndef BLATT3_TYPE_HPP
+#define BLATT3_TYPE_HPP
+#include <string_view>
+#include "Symbol.hpp"
+
+/**
+ * Types of the constants. Types are symbols of the SymbolTable, a constant can have several types (e.g. a block is
+ * a Block and a Location) and constants without declaration have no type. The membership of a constant is stored as
+ * bit per Symbol, so tests take O(1) and can be used in the inner loops of the grounding
+ */
+class TypeTable {
+public:
+    /**
+     * Adds type to the types of object
+     * @param object constant
+     * @param type
+     */
+    static void declare(std::string_view object, std::string_view type);
+
+    /**
+     * @param object
+     * @param type
+     * @return true if object is a constant that was declared with type
+     */
+    static bool isA(Term object, Symbol type);
+};
+
+#endif //BLATT3_TYPE_HPP
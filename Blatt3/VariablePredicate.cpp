@@ -5,9 +5,26 @@
 #include "VariablePredicate.hpp"
 #include "util.hpp"
 #include <cassert>
+#include <algorithm>
 
-VariablePredicate::VariablePredicate(std::string name, std::size_t numVars, bool truthVal) :
-    name(std::move(name)), variables(numVars), truthVal(truthVal) {}
+namespace {
+    auto resolve(Term term, const VariablePredicate::Substitution &substitution) -> Term {
+        if (!term.isVariable()) {
+            return term;
+        }
+
+        for (const auto &[variable, value] : substitution) {
+            if (variable == term) {
+                return value;
+            }
+        }
+
+        return term;
+    }
+}
+
+VariablePredicate::VariablePredicate(std::string_view name, std::size_t numVars, bool truthVal) :
+    name(SymbolTable::intern(name)), variables(numVars), truthVal(truthVal) {}
 
 bool VariablePredicate::partialEqual(const VariablePredicate &other) const {
     if (!typeEqual(other)) {
@@ -26,37 +43,38 @@ bool VariablePredicate::isAtomic() const {
     });
 }
 
-VariablePredicate::VariablePredicate(std::string name, std::vector<std::string> variables, bool truthVal) :
-    name(std::move(name)), variables(std::move(variables)), truthVal(truthVal) {}
+VariablePredicate::VariablePredicate(std::string_view name, const std::vector<std::string> &variables,
+                                     bool truthVal) : name(SymbolTable::intern(name)), truthVal(truthVal) {
+    this->variables.reserve(variables.size());
+    for (const auto &v : variables) {
+        this->variables.emplace_back(v);
+    }
+}
+
+VariablePredicate::VariablePredicate(Symbol name, std::vector<Term> variables, bool truthVal) :
+    name(name), variables(std::move(variables)), truthVal(truthVal) {}
 
 std::ostream &operator<<(std::ostream &out, const VariablePredicate &v) {
     if (!v.truthVal) {
         out << "¬";
     }
 
-    out << v.name << "(";
+    out << SymbolTable::name(v.name) << "(";
     util::printList(out, v.variables, util::BraceType::Par);
     return out;
 }
 
-bool VariablePredicate::isVariable(const std::string &varName) {
-    return varName.starts_with('<') && varName.ends_with('>');
+bool VariablePredicate::isVariable(Term term) {
+    return term.isVariable();
 }
 
 void VariablePredicate::applySubstitution(const VariablePredicate::Substitution &substitution) {
     for (auto &v : variables) {
-        if (!isVariable(v)) {
-            continue;
-        }
-
-        auto it = substitution.find(v);
-        if (it != substitution.end()) {
-            v = it->second;
-        }
+        v = resolve(v, substitution);
     }
 }
 
-void VariablePredicate::applySubstitution(const std::string &oldName, const std::string &newName) {
+void VariablePredicate::applySubstitution(Term oldName, Term newName) {
     for (auto &v : variables) {
         if (isVariable(v) && v == oldName) {
             v = newName;
@@ -64,7 +82,7 @@ void VariablePredicate::applySubstitution(const std::string &oldName, const std:
     }
 }
 
-auto VariablePredicate::getVariables() const -> const std::vector<std::string> & {
+auto VariablePredicate::getVariables() const -> const std::vector<Term> & {
     return variables;
 }
 
@@ -72,7 +90,7 @@ bool VariablePredicate::typeEqual(const VariablePredicate &other) const {
     return name == other.name && variables.size() == other.variables.size();
 }
 
-bool VariablePredicate::varInequal(const std::string &v1, const std::string &v2) {
+bool VariablePredicate::varInequal(Term v1, Term v2) {
     return !isVariable(v1) && !isVariable(v2) && v1 != v2;
 }
 
@@ -80,7 +98,7 @@ auto VariablePredicate::constants() const -> std::set<std::string> {
     std::set<std::string> ret;
     for (const auto &v : variables) {
         if (!isVariable(v)) {
-            ret.emplace(v);
+            ret.emplace(v.getName());
         }
     }
 
@@ -88,9 +106,25 @@ auto VariablePredicate::constants() const -> std::set<std::string> {
 }
 
 auto VariablePredicate::getName() const -> const std::string & {
+    return SymbolTable::name(name);
+}
+
+auto VariablePredicate::getSymbol() const -> Symbol {
     return name;
 }
 
+auto VariablePredicate::atomHash() const -> std::uint64_t {
+    std::uint64_t hash = 0xcbf29ce484222325ull ^ name;
+    for (const auto &v : variables) {
+        hash = (hash ^ Term::Hash()(v)) * 0x100000001b3ull;
+    }
+
+    // splitmix64 finalizer, the table of State uses the low bits
+    hash = (hash ^ (hash >> 30u)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27u)) * 0x94d049bb133111ebull;
+    return hash ^ (hash >> 31u);
+}
+
 void VariablePredicate::setTruthVal(bool newTruthVal) {
     this->truthVal = newTruthVal;
 }
@@ -107,44 +141,41 @@ bool VariablePredicate::getTruthVal() const {
     return truthVal;
 }
 
-static bool findSubstitution(VariablePredicate &v1, VariablePredicate &v2,
-                             VariablePredicate::Substitution &s1, VariablePredicate::Substitution &s2) {
-    if (v1.partialEqual(v2)) {
-        return true;
-    }
-
-    auto it1 = v1.getVariables().cbegin();
-    auto it2 = v2.getVariables().cbegin();
-    while (it1 != v1.getVariables().end()) {
-        if (VariablePredicate::varInequal(*it1, *it2)) {
-            return false;
-        }
-
-        if (VariablePredicate::isVariable(*it1) && !VariablePredicate::isVariable(*it2)) {
-            std::string oldVal = *it1;
-            v1.applySubstitution(oldVal, *it2);
-            s1[oldVal] = *it2;
-        }
-
-        ++it1; ++it2;
-    }
-
-    return findSubstitution(v2, v1, s2, s1);
-}
-
 auto findSubstitution(const VariablePredicate &vp1, const VariablePredicate &vp2)
 -> std::optional<std::pair<VariablePredicate::Substitution, VariablePredicate::Substitution>> {
     if (!vp1.typeEqual(vp2)) {
         return {};
     }
 
-    VariablePredicate v1 = vp1;
-    VariablePredicate v2 = vp2;
+    const auto &args1 = vp1.getVariables();
+    const auto &args2 = vp2.getVariables();
     VariablePredicate::Substitution s1;
     VariablePredicate::Substitution s2;
-    if (!findSubstitution(v1, v2, s1, s2)) {
-        return {};
-    } else {
-        return {{std::move(s1), std::move(s2)}};
+    // binding a variable of one predicate can allow binding a variable of the other one at another position, so the
+    // arguments are compared until nothing changes
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (std::size_t i = 0; i < args1.size(); ++i) {
+            const auto a = resolve(args1[i], s1);
+            const auto b = resolve(args2[i], s2);
+            if ((a.isVariable() && b.isVariable()) || a == b) {
+                continue;
+            }
+
+            if (VariablePredicate::varInequal(a, b)) {
+                return {};
+            }
+
+            if (a.isVariable()) {
+                s1.emplace_back(a, b);
+            } else {
+                s2.emplace_back(b, a);
+            }
+
+            changed = true;
+        }
     }
+
+    return {{std::move(s1), std::move(s2)}};
 }
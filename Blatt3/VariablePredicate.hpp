@@ -8,15 +8,26 @@
 #include <vector>
 #include <string>
 #include <ostream>
-#include <unordered_map>
 #include <set>
-
+#include <optional>
+#include <cstdint>
+#include "Symbol.hpp"
+
+/**
+ * Predicate over interned terms. The name and all arguments are symbols of the SymbolTable, so all comparisons and
+ * substitutions work on integers
+ */
 class VariablePredicate {
 public:
-    using Substitution = std::unordered_map<std::string, std::string>;
+    /**
+     * Pairs of variable and value, every variable occurs at most once. Substitutions have one entry per variable of a
+     * predicate or operator, so they are searched linearly
+     */
+    using Substitution = std::vector<std::pair<Term, Term>>;
 
-    VariablePredicate(std::string name, std::size_t numVars, bool truethVal = true);
-    VariablePredicate(std::string name, std::vector<std::string> variables, bool truthVal = true);
+    VariablePredicate(std::string_view name, std::size_t numVars, bool truethVal = true);
+    VariablePredicate(std::string_view name, const std::vector<std::string> &variables, bool truthVal = true);
+    VariablePredicate(Symbol name, std::vector<Term> variables, bool truthVal = true);
 
     /**
      * True if this and other are equal in all respective constants and all free variables of this are matched with
@@ -51,24 +62,32 @@ public:
 
     void applySubstitution(const Substitution &substitution);
 
-    void applySubstitution(const std::string &oldName, const std::string &newName);
+    void applySubstitution(Term oldName, Term newName);
 
-    static bool isVariable(const std::string &varName);
+    static bool isVariable(Term term);
 
-    static bool varInequal(const std::string &v1, const std::string &v2);
+    static bool varInequal(Term v1, Term v2);
 
-    [[nodiscard]] auto getVariables() const -> const std::vector<std::string> &;
+    [[nodiscard]] auto getVariables() const -> const std::vector<Term> &;
 
     [[nodiscard]] auto constants() const -> std::set<std::string>;
 
     [[nodiscard]] auto getName() const -> const std::string &;
 
+    [[nodiscard]] auto getSymbol() const -> Symbol;
+
+    /**
+     * Hash of the name and the arguments, the truth value is ignored (equal for atomicEqual predicates)
+     * @return
+     */
+    [[nodiscard]] auto atomHash() const -> std::uint64_t;
+
     void setTruthVal(bool newTruthVal);
 
     [[nodiscard]] bool getTruthVal() const;
 private:
-    std::string name;
-    std::vector<std::string> variables;
+    Symbol name;
+    std::vector<Term> variables;
     bool truthVal;
 
     friend std::ostream &operator<<(std::ostream &out, const VariablePredicate &v);
@@ -1,67 +1,180 @@
 #include <iostream>
 #include <deque>
 #include <vector>
+#include <unordered_set>
+#include <memory>
+#include <iterator>
+#include <string>
+#include <cstdlib>
+#include <cassert>
 #include "VariablePredicate.hpp"
 #include "Operator.hpp"
+#include "MatchNetwork.hpp"
+#include "Reachability.hpp"
+#include "ThreadPool.hpp"
+#include "Type.hpp"
 #include "State.hpp"
+#include "Statistics.hpp"
 
-int main() {
-    const State init({
-                             VariablePredicate("On", {"A", "Floor"}),
-                             VariablePredicate("On", {"B", "Floor"}),
-                             VariablePredicate("On", {"C", "A"}),
-                             VariablePredicate("Clear", {"Floor"}),
-                             VariablePredicate("Clear", {"B"}),
-                             VariablePredicate("Clear", {"C"})
-                     });
-
-    const State goal({
-                             VariablePredicate("On", {"C", "Floor"}),
-                             VariablePredicate("On", {"B", "C"}),
-                             VariablePredicate("On", {"A", "B"}),
-                     });
-
-    Operator move("Move", {
-                          VariablePredicate("On", {"<X>", "<Y>"}),
-                          VariablePredicate("Clear", {"<X>"}),
-                          VariablePredicate("Clear", {"<Z>"})
-                  },
-                  {
-                          VariablePredicate("On", {"<X>", "<Z>"}),
-                          VariablePredicate("Clear", {"<Y>"}),
-                          VariablePredicate("Clear", {"Floor"}),
-                          VariablePredicate("On", {"<X>", "<Y>"}, false),
-                          VariablePredicate("Clear", {"<Z>"}, false)
-                  });
+/*
+ * Breadth first search for the typed blocks world: blocks are of type Block and Location, the floor is a Location.
+ * Every operator is grounded by a MatchNetwork, the memories of an expanded state are derived from the memories of its
+ * parent. This incremental grounding is timed as ground phase, not as search. Before the search, a relaxed
+ * reachability analysis restricts the networks to the reachable ground actions and detects unreachable goals. The
+ * search is only traced to cout if compiled with VERBOSE.
+ * Blatt3 [<blocks>] [<cache file>]
+ * The number of blocks defaults to 3: all blocks but the last one are on the floor, the last one is on the first one,
+ * and the target is the reversed tower with the last block at the bottom. If a cache file is given, the reachability
+ * analysis is read from it or written to it.
+ */
+
+auto blockName(std::size_t i) -> std::string {
+    if (i < 26) {
+        return std::string(1, static_cast<char>('A' + i));
+    }
+
+    return "B" + std::to_string(i);
+}
+
+int main(int argc, char **argv) {
+    Statistics stats("Blatt3");
+    stats.begin(Statistics::Phase::Parse);
+    const std::size_t numBlocks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 3;
+    assert(numBlocks >= 2);
+    TypeTable::declare("Floor", "Location");
+    for (std::size_t i = 0; i < numBlocks; ++i) {
+        TypeTable::declare(blockName(i), "Block");
+        TypeTable::declare(blockName(i), "Location");
+    }
+
+    State::PredList initPreds;
+    for (std::size_t i = 0; i + 1 < numBlocks; ++i) {
+        initPreds.emplace_back("On", std::vector<std::string>{blockName(i), "Floor"});
+    }
+
+    initPreds.emplace_back("On", std::vector<std::string>{blockName(numBlocks - 1), blockName(0)});
+    initPreds.emplace_back("Clear", std::vector<std::string>{"Floor"});
+    for (std::size_t i = 1; i < numBlocks; ++i) {
+        initPreds.emplace_back("Clear", std::vector<std::string>{blockName(i)});
+    }
+
+    State::PredList goalPreds = {VariablePredicate("On", {blockName(numBlocks - 1), "Floor"})};
+    for (std::size_t i = numBlocks - 1; i > 0; --i) {
+        goalPreds.emplace_back("On", std::vector<std::string>{blockName(i - 1), blockName(i)});
+    }
+
+    const State init(std::move(initPreds));
+    const State goal(std::move(goalPreds));
+
+    // the floor is always clear, so it is only a location and blocks are moved onto it by MoveToFloor
+    const std::vector<Operator> operators = {
+            Operator("Move", {
+                             VariablePredicate("On", {"<X>", "<Y>"}),
+                             VariablePredicate("Clear", {"<X>"}),
+                             VariablePredicate("Clear", {"<Z>"})
+                     },
+                     {
+                             VariablePredicate("On", {"<X>", "<Z>"}),
+                             VariablePredicate("Clear", {"<Y>"}),
+                             VariablePredicate("On", {"<X>", "<Y>"}, false),
+                             VariablePredicate("Clear", {"<Z>"}, false)
+                     }, {{"<X>", "Block"}, {"<Y>", "Location"}, {"<Z>", "Block"}}),
+            Operator("MoveToFloor", {
+                             VariablePredicate("On", {"<X>", "<Y>"}),
+                             VariablePredicate("Clear", {"<X>"})
+                     },
+                     {
+                             VariablePredicate("On", {"<X>", "Floor"}),
+                             VariablePredicate("Clear", {"<Y>"}),
+                             VariablePredicate("On", {"<X>", "<Y>"}, false)
+                     }, {{"<X>", "Block"}, {"<Y>", "Block"}})
+    };
+    stats.end(Statistics::Phase::Parse);
+#ifdef VERBOSE
     std::cout << init << std::endl;
-    std::cout << move << std::endl;
-    std::deque<State> fringe = {init};
-    std::vector<State> visited;
+    for (const auto &op : operators) {
+        std::cout << op << std::endl;
+    }
+#endif
+    stats.begin(Statistics::Phase::Ground);
+    ThreadPool pool;
+    const auto reachability = argc > 2 ? Reachability::cached(argv[2], operators, init, true, pool)
+                                       : Reachability(operators, init, true, pool);
+    stats.end(Statistics::Phase::Ground);
+    if (!reachability.mayReach(goal)) {
+        std::cout << "Unsolvable!" << std::endl;
+        return 0;
+    }
+
+    Statistics::Timer searchTimer(stats, Statistics::Phase::Search);
+    std::vector<MatchNetwork> networks;
+    for (const auto &op : operators) {
+        networks.emplace_back(op, true);
+        networks.back().restrict(reachability.getActions());
+    }
+
+    // the memories of the match networks are computed when a state is expanded, from the memories of its parent
+    using Memories = std::vector<MatchNetwork::Memory>;
+    struct Node {
+        State state;
+        std::shared_ptr<const Memories> parentMemories;
+        MatchNetwork::Delta delta;
+    };
+
+    std::deque<Node> fringe;
+    fringe.push_back({init, nullptr, {}});
+    std::unordered_set<State, State::Hash> visited = {init};
     while (!fringe.empty()) {
-        State current = std::move(fringe.front());
+        stats.openSize(fringe.size());
+        auto [current, parentMemories, delta] = std::move(fringe.front());
         fringe.pop_front();
+#ifdef VERBOSE
         std::cout << "Current " << current << std::endl;
+#endif
         if (current.isSolutionOf(goal)) {
             std::cout << "Goal reached by sequence" << std::endl;
             std::cout << current.getActionSequence() << std::endl;
             return 0;
         }
 
-        auto actions = move.makeApplicable(current, false);
+        stats.expanded();
+        // the phases are disjoint, the grounding of an expanded state is not counted as search time
+        stats.end(Statistics::Phase::Search);
+        stats.begin(Statistics::Phase::Ground);
+        auto memories = std::make_shared<Memories>();
+        std::vector<Operator> actions;
+        for (std::size_t i = 0; i < networks.size(); ++i) {
+            memories->emplace_back(parentMemories ? networks[i].update((*parentMemories)[i], delta)
+                                                  : networks[i].match(current));
+            auto instantiations = networks[i].instantiate(memories->back(), current);
+            std::move(instantiations.begin(), instantiations.end(), std::back_inserter(actions));
+        }
+
+        stats.end(Statistics::Phase::Ground);
+        stats.begin(Statistics::Phase::Search);
+#ifdef VERBOSE
         std::cout << "Possible actions:" << std::endl;
+#endif
         for (const auto &action : actions) {
             if (action.applicableTo(current)) {
+                stats.generated();
                 State successor = action.applyTo(current);
-                auto res = std::find(visited.begin(), visited.end(), successor);
-                if (res == visited.end()) {
+                if (visited.insert(successor).second) {
+#ifdef VERBOSE
                     std::cout << action << std::endl;
-                    fringe.emplace_back(successor);
-                    visited.emplace_back(std::move(successor));
+#endif
+                    auto successorDelta = MatchNetwork::delta(current, successor);
+                    fringe.push_back({std::move(successor), memories, std::move(successorDelta)});
+                } else {
+                    stats.duplicate();
                 }
             }
         }
 
+        stats.closedSize(visited.size());
+#ifdef VERBOSE
         std::cout << std::endl;
+#endif
     }
 
     std::cout << "Unsolvable!" << std::endl;
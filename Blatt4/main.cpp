@@ -86,9 +86,6 @@ public:
         util::appendPredicates(neg, predicates, false);
     }
 
-    State(PredList preds, std::string actionSequence) : predicates(std::move(preds)),
-                                                        actionSequence(std::move(actionSequence)) {}
-
     auto getPredicates() const -> const PredList & {
         return predicates;
     }
@@ -106,17 +103,12 @@ public:
         return true;
     }
 
-    auto getActionSequence() const -> const std::string & {
-        return actionSequence;
-    }
-
     bool operator==(const State &other) const {
         return predicates == other.getPredicates();
     }
 
 private:
     PredList predicates;
-    std::string actionSequence;
 };
 
 class Action {
@@ -166,17 +158,11 @@ public:
     State applyTo(const State &state) const {
         assert(applicable(state));
         PredList preds = state.getPredicates();
-        auto actionSeq = state.getActionSequence();
-        if (!actionSeq.empty()) {
-            actionSeq.append(",");
-        }
-
-        actionSeq.append(name);
         for (const auto &effect : effects) {
             preds[effect.first] = effect.second;
         }
 
-        return State(std::move(preds), std::move(actionSeq));
+        return State(std::move(preds));
     }
 
     Action makePositive(const std::unordered_set<std::string> &negatives) const {
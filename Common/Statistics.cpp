@@ -0,0 +1,58 @@
+#include "Statistics.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <unistd.h>
+
+Statistics::Statistics(std::string tool) : tool(std::move(tool)) {
+    const char *fdName = std::getenv("STRIPS_STATS_FD");
+    if (fdName != nullptr && *fdName != '\0') {
+        char *end;
+        auto value = std::strtol(fdName, &end, 10);
+        if (*end == '\0' && value >= 0) {
+            fd = static_cast<int>(value);
+        }
+    }
+}
+
+Statistics::~Statistics() {
+    write();
+}
+
+void Statistics::write() const {
+    if (fd < 0) {
+        return;
+    }
+
+    auto seconds = [this](Phase phase) {
+        return std::chrono::duration<double>(elapsed[index(phase)]).count();
+    };
+
+    char buffer[512];
+    const int n = std::snprintf(buffer, sizeof(buffer),
+                                "{\"tool\":\"%s\",\"expansions\":%zu,\"generations\":%zu,\"duplicates\":%zu,"
+                                "\"peakOpen\":%zu,\"peakClosed\":%zu,\"heuristicEvaluations\":%zu,"
+                                "\"time\":{\"parse\":%.6f,\"ground\":%.6f,\"search\":%.6f}}\n",
+                                tool.c_str(), expansions, generations, duplicates, peakOpen, peakClosed,
+                                heuristicEvaluations, seconds(Phase::Parse), seconds(Phase::Ground),
+                                seconds(Phase::Search));
+    if (n <= 0) {
+        return;
+    }
+
+    const char *data = buffer;
+    auto remaining = std::min(static_cast<std::size_t>(n), sizeof(buffer) - 1);
+    while (remaining > 0) {
+        auto written = ::write(fd, data, remaining);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (written <= 0) {
+            return;
+        }
+
+        data += written;
+        remaining -= static_cast<std::size_t>(written);
+    }
+}
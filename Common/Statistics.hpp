@@ -0,0 +1,105 @@
+#ifndef COMMON_STATISTICS_HPP
+#define COMMON_STATISTICS_HPP
+#include <array>
+#include <chrono>
+#include <string>
+#include <cstddef>
+#include <algorithm>
+
+/**
+ * Search counters and phase timers. The counters are plain increments so they can stay in the inner loops. If the
+ * environment variable STRIPS_STATS_FD names a file descriptor, the statistics are written to it as a single JSON
+ * object when the object is destroyed, otherwise nothing is written. The class is shared by the planners of all
+ * exercises, so they report the same schema. Phases must not overlap: a phase that interrupts another ends it first
+ */
+class Statistics {
+public:
+    enum class Phase {
+        Parse, Ground, Search
+    };
+
+    /**
+     * Measures a phase for the lifetime of the object
+     */
+    class Timer {
+    public:
+        Timer(Statistics &stats, Phase phase) : stats(stats), phase(phase) {
+            stats.begin(phase);
+        }
+
+        Timer(const Timer &) = delete;
+        auto operator=(const Timer &) -> Timer & = delete;
+
+        ~Timer() {
+            stats.end(phase);
+        }
+
+    private:
+        Statistics &stats;
+        Phase phase;
+    };
+
+    explicit Statistics(std::string tool);
+    Statistics(const Statistics &) = delete;
+    auto operator=(const Statistics &) -> Statistics & = delete;
+    ~Statistics();
+
+    /**
+     * Starts the timer of a phase. A phase can be entered several times, the durations add up
+     * @param phase
+     */
+    void begin(Phase phase) {
+        started[index(phase)] = Clock::now();
+    }
+
+    void end(Phase phase) {
+        elapsed[index(phase)] += Clock::now() - started[index(phase)];
+    }
+
+    void expanded() {
+        ++expansions;
+    }
+
+    void generated(std::size_t n = 1) {
+        generations += n;
+    }
+
+    void duplicate() {
+        ++duplicates;
+    }
+
+    void heuristicEvaluated() {
+        ++heuristicEvaluations;
+    }
+
+    void openSize(std::size_t size) {
+        peakOpen = std::max(peakOpen, size);
+    }
+
+    void closedSize(std::size_t size) {
+        peakClosed = std::max(peakClosed, size);
+    }
+
+private:
+    void write() const;
+
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::size_t NumPhases = 3;
+
+    static constexpr auto index(Phase phase) -> std::size_t {
+        return static_cast<std::size_t>(phase);
+    }
+
+    std::string tool;
+    int fd = -1;
+    std::size_t expansions = 0;
+    std::size_t generations = 0;
+    std::size_t duplicates = 0;
+    std::size_t heuristicEvaluations = 0;
+    std::size_t peakOpen = 0;
+    std::size_t peakClosed = 0;
+    std::array<Clock::time_point, NumPhases> started{};
+    std::array<Clock::duration, NumPhases> elapsed{};
+};
+
+#endif //COMMON_STATISTICS_HPP